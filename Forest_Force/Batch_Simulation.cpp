@@ -0,0 +1,722 @@
+/******************************************************************************/
+/*!
+\file		Batch_Simulation.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Batch_Simulation class. A batch runs many
+			instances of one Map in lockstep, each with its own spells, wind
+			and spread rolls, for what-if work that plays the same level under
+			many different inputs.
+			The tiles of every instance are interleaved, the instances of one
+			tile sit next to each other. The fire/water stencil of a row is
+			summed for every instance in one pass, 16 byte lanes at a time
+			with SSE2, each lane with the wind shape of its own instance. The
+			tiles are then updated with the Map's own Fire_Behaviour,
+			Earth_Behaviour and State_Behaviour, so an instance plays out
+			exactly like a Map. Only the span of each row next to a tile that
+			was busy last tick in any instance is visited, and within it only
+			the instances that were busy around the tile are updated, the
+			same tiles each Map would update.
+			Define FIRE_STENCIL_NO_SIMD to build without the SSE2 kernel.
+			The main functions of Batch_Simulation.cpp are:
+			-Load
+				Starts every instance from a Map as it is now
+			-Queue_Command
+				Queues a spell for one instance, applied on the next tick
+			-Simulate_Tick
+				Advances every instance by one tick
+			-Get_Tile
+				A tile of one instance
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Batch_Simulation.hpp"
+#include "Thread_Pool.hpp"
+#include <algorithm>					// std::min, std::max, std::fill_n
+
+#if !defined(FIRE_STENCIL_NO_SIMD) && (defined(_M_X64) || defined(__x86_64__))
+#define BATCH_SIMULATION_SSE2
+#include <emmintrin.h>					// SSE2 intrinsics
+#endif
+
+namespace
+{
+	// Bands are only split off for this many tile updates each
+	const size_t MIN_BAND_TILES{ 4096 };
+	// Bits of the 3x3 stencil
+	const s32 STENCIL_BITS{ 9 };
+	// Lanes summed at a time, every row of lanes is padded past its end by as many
+	const size_t LANE_BLOCK{ 16 };
+
+	/**************************************************************************/
+	/*!
+		 Ticks wind blows for once it is set to blow for seconds, counted
+		 down the way Map::Wind_Behaviour does
+	*/
+	/**************************************************************************/
+	s32 Wind_Ticks(f64 seconds)
+	{
+		s32 ticks{};
+		if (BEHAVIOUR_TIME <= 0)
+			return 1;
+		do
+		{
+			++ticks;
+			seconds -= BEHAVIOUR_TIME;
+		} while (seconds > 0);
+		return ticks;
+	}
+}
+
+/**************************************************************************/
+/*!
+	 Batch_Simulation Destructor, frees the grids
+*/
+/**************************************************************************/
+Batch_Simulation::~Batch_Simulation()
+{
+	Unload();
+}
+
+/**************************************************************************/
+/*!
+	 This function starts count instances from source as it is now, spells
+	 still queued on source included. The spread rolls of every instance
+	 start from seed 0, see Set_Spread_Seed. Returns false if source has no
+	 Map loaded
+*/
+/**************************************************************************/
+bool Batch_Simulation::Load(Map& source, s32 count)
+{
+	if (count <= 0 || source.Get_X_Size() <= 0 || source.Get_Y_Size() <= 0 || source.Get_Display_Grid().memory == nullptr)
+		return false;
+
+	rules.Clone_From(source);
+	// Queued spells would be applied before the next tick anyway
+	rules.Apply_Commands();
+	x_size = rules.Get_X_Size();
+	y_size = rules.Get_Y_Size();
+	instance_count = count;
+	stride = x_size + 2;
+
+	// Halo tiles are grass with no fire, like the halo of a Map
+	Tiles halo{};
+	halo.Set_Tile_Type(Map::GRASS);
+	size_t const tiles{ static_cast<size_t>(stride) * static_cast<size_t>(y_size + 2) * static_cast<size_t>(count) + LANE_BLOCK };
+	grids[0].assign(tiles, halo);
+	grids[1].assign(tiles, halo);
+	busy_lanes[0].assign(tiles, 0);
+	busy_lanes[1].assign(tiles, 0);
+	current = 0;
+
+	// Tiles a tick leaves alone keep what the grid it writes held, so the grid of the tick before is kept as well
+	Tile_Grid const display{ rules.Get_Display_Grid() };
+	Tile_Grid const refer{ rules.Get_Refer_Grid() };
+	house_rows.clear();
+	for (s32 y{}; y < y_size; ++y)
+	{
+		bool houses{};
+		for (s32 x{}; x < x_size; ++x)
+		{
+			std::fill_n(grids[0].begin() + static_cast<ptrdiff_t>(Index(x, y)), count, display[y][x]);
+			std::fill_n(grids[1].begin() + static_cast<ptrdiff_t>(Index(x, y)), count, refer[y][x]);
+			// Nothing is known about which tiles will change until every tile has been updated once
+			std::fill_n(busy_lanes[0].begin() + static_cast<ptrdiff_t>(Index(x, y)), count, static_cast<u8>(1));
+			houses = houses || display[y][x].Get_Terrain_Type() == Map::HOUSE;
+		}
+		if (houses)
+		{
+			house_rows.push_back(y);
+		}
+	}
+
+	Fire_Conditions const conditions{ rules.Get_Fire_Conditions() };
+	fire_spread_ticks = conditions.spread_ticks;
+	fire_ticks_left = conditions.ticks_to_spread;
+	Batch_Instance first{};
+	first.wind_direction = conditions.wind_direction;
+	first.wind_ticks = conditions.wind_ticks;
+	first.house_durability = rules.Get_Curr_House_Durability();
+	first.tree_count = rules.Wood_Count();
+	first.houses_left = !house_rows.empty();
+	instances.assign(static_cast<size_t>(count), first);
+
+	span_first.assign(static_cast<size_t>(y_size), 0);
+	span_last.assign(static_cast<size_t>(y_size), x_size - 1);
+	fire_masks.assign(static_cast<size_t>(STENCIL_BITS) * static_cast<size_t>(stride) * static_cast<size_t>(count) + LANE_BLOCK, 0);
+	bands.clear();
+	return true;
+}
+
+/**************************************************************************/
+/*!
+	 This function frees the grids and the copy of the Map loaded from
+*/
+/**************************************************************************/
+void Batch_Simulation::Unload()
+{
+	rules.Map_Unload();
+	grids[0] = std::vector<Tiles>{};
+	grids[1] = std::vector<Tiles>{};
+	busy_lanes[0] = std::vector<u8>{};
+	busy_lanes[1] = std::vector<u8>{};
+	fire_masks.clear();
+	instances.clear();
+	bands.clear();
+	span_first.clear();
+	span_last.clear();
+	awake_rows.clear();
+	house_rows.clear();
+	x_size = y_size = instance_count = stride = 0;
+}
+
+/**************************************************************************/
+/*!
+	 This function queues a spell effect for one instance, applied at the
+	 start of the next tick like Map::Queue_Command
+*/
+/**************************************************************************/
+void Batch_Simulation::Queue_Command(s32 instance, u8 command, s32 x_value, s32 y_value, s8 value)
+{
+	if (instance < 0 || instance >= instance_count)
+		return;
+	instances[static_cast<size_t>(instance)].commands.push_back(Map_Command{ command, x_value, y_value, value });
+}
+
+/**************************************************************************/
+/*!
+	 This function sets the chance that fire spreading onto a tile catches,
+	 for every instance, see Map::Set_Spread_Chance
+*/
+/**************************************************************************/
+void Batch_Simulation::Set_Spread_Chance(f32 chance)
+{
+	rules.Set_Spread_Chance(chance, 0);
+}
+
+/**************************************************************************/
+/*!
+	 This function sets the seed the spread rolls of one instance are
+	 drawn from, instances with the same seed and spells play out the same
+*/
+/**************************************************************************/
+void Batch_Simulation::Set_Spread_Seed(s32 instance, u64 seed)
+{
+	if (instance < 0 || instance >= instance_count)
+		return;
+	instances[static_cast<size_t>(instance)].spread_roll = seed;
+}
+
+/**************************************************************************/
+/*!
+	 This function wakes the tiles x_first to x_last of a row for the next
+	 tick, clamped to the Map
+*/
+/**************************************************************************/
+void Batch_Simulation::Wake(s32 y_value, s32 x_first, s32 x_last)
+{
+	if (y_value < 0 || y_value >= y_size)
+		return;
+	span_first[y_value] = std::min(span_first[y_value], std::max(x_first, 0));
+	span_last[y_value] = std::max(span_last[y_value], std::min(x_last, x_size - 1));
+}
+
+/**************************************************************************/
+/*!
+	 This function marks a tile of one instance as changed before the
+	 tick, so it and the tiles around it are updated in that instance
+*/
+/**************************************************************************/
+void Batch_Simulation::Wake_Lane(s32 instance, s32 x_value, s32 y_value)
+{
+	busy_lanes[current][Index(x_value, y_value) + static_cast<size_t>(instance)] = 1;
+	for (s32 j{ -1 }; j < 2; ++j)
+	{
+		Wake(y_value + j, x_value - 1, x_value + 1);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function applies the queued spells of every instance, the same
+	 way Map::Set_Fire, Map::Set_Earth and Map::Set_Wind change a Map.
+	 Commands for tiles outside the Map are dropped
+*/
+/**************************************************************************/
+void Batch_Simulation::Apply_Commands()
+{
+	std::vector<Tiles>& grid = grids[current];
+	std::vector<Tiles>& other = grids[1 - current];
+	for (size_t k{}; k < instances.size(); ++k)
+	{
+		Batch_Instance& instance = instances[k];
+		for (Map_Command const& command : instance.commands)
+		{
+			if (command.command == Map::SET_WIND)
+			{
+				instance.wind_direction = static_cast<u8>(command.value);
+				instance.wind_ticks = Wind_Ticks(rules.max_wind_time);
+				continue;
+			}
+			if (command.x < 0 || command.x >= x_size || command.y < 0 || command.y >= y_size)
+				continue;
+
+			Tiles& tile = grid[Index(command.x, command.y) + k];
+			if (command.command == Map::SET_FIRE)
+			{
+				if (tile.Get_Terrain_Type() >= Map::HILL || tile.Get_Tile_Type() == Map::RIVER)
+					continue;
+				tile.Set_Fire(command.value);
+			}
+			else if (command.command == Map::SET_EARTH)
+			{
+				if (tile.Get_Terrain_Type() == Map::ENEMY)
+					continue;
+				tile.Set_Earth_Permanant(false);
+				other[Index(command.x, command.y) + k].Set_Earth_Permanant(false);
+				tile.Set_Earth_Durability(rules.max_earth_durability);
+				tile.Set_Wood_Durability(0);
+				tile.Set_Terrain_Type(Map::MOUNTAIN);
+			}
+			Wake_Lane(static_cast<s32>(k), command.x, command.y);
+		}
+		instance.commands.clear();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function unpacks the fire and river of tiles x_first - 1 to
+	 x_last + 1 of a row into a stencil row of a band, every instance of a
+	 tile side by side. The tiles of a row are one run in the grid, so it
+	 is unpacked like one long map row
+*/
+/**************************************************************************/
+void Batch_Simulation::Load_Row(Batch_Band& band, s32 slot, s32 y_value, s32 x_first, s32 x_last)
+{
+	size_t const first{ static_cast<size_t>(x_first) * static_cast<size_t>(instance_count) };
+	Unpack_Fire_Row(grids[current].data() + Index(x_first - 1, y_value), (x_last - x_first + 3) * instance_count,
+		band.fire_rows[slot].data() + first, band.river_rows[slot].data() + first);
+}
+
+/**************************************************************************/
+/*!
+	 This function sums the fire/water stencil of tiles x_first to x_last
+	 of a row for every instance into the totals of a band, and whether a
+	 tile around was busy last tick. Every instance collects fire in the
+	 shape of its own wind, so the shape is a mask for each lane. The
+	 lanes of the run are summed 16 at a time, the neighbours of a lane
+	 are a fixed distance away in the rows above, at and below
+*/
+/**************************************************************************/
+void Batch_Simulation::Sum_Row(Batch_Band& band, s32 y_value, s32 x_first, s32 x_last)
+{
+	if (band.row + 1 == y_value && band.x_first == x_first && band.x_last == x_last)
+	{
+		std::swap(band.fire_rows[0], band.fire_rows[1]);
+		std::swap(band.fire_rows[1], band.fire_rows[2]);
+		std::swap(band.river_rows[0], band.river_rows[1]);
+		std::swap(band.river_rows[1], band.river_rows[2]);
+		Load_Row(band, 2, y_value + 1, x_first, x_last);
+	}
+	else
+	{
+		for (s32 slot{}; slot < 3; ++slot)
+		{
+			Load_Row(band, slot, y_value - 1 + slot, x_first, x_last);
+		}
+	}
+	band.row = y_value;
+	band.x_first = x_first;
+	band.x_last = x_last;
+
+	size_t const count{ static_cast<size_t>(instance_count) };
+	size_t const row_lanes{ static_cast<size_t>(stride) * count };
+	size_t const first{ static_cast<size_t>(x_first) * count };
+	size_t const last{ static_cast<size_t>(x_last + 1) * count };
+	u16 const water_mask{ Get_Water_Stencil_Mask() };
+	s8 const* fire_rows[3]{ band.fire_rows[0].data(), band.fire_rows[1].data(), band.fire_rows[2].data() };
+	u8 const* river_rows[3]{ band.river_rows[0].data(), band.river_rows[1].data(), band.river_rows[2].data() };
+	u8 const* busy_rows[3]{};
+	for (s32 j{ -1 }; j < 2; ++j)
+	{
+		busy_rows[j + 1] = busy_lanes[current].data() + Index(-1, y_value + j);
+	}
+
+#if defined(BATCH_SIMULATION_SSE2)
+	// A lane compare gives 0 or -1, so subtracting it counts and and-ing with it masks the sum
+	__m128i const zero{ _mm_setzero_si128() };
+	for (size_t n{ first }; n < last; n += LANE_BLOCK)
+	{
+		__m128i fire_sum{ zero }, fire_count{ zero }, water_sum{ zero }, water_count{ zero }, river{ zero }, awake{ zero };
+		for (s32 j{ -1 }; j < 2; ++j)
+		{
+			for (s32 i{ -1 }; i < 2; ++i)
+			{
+				s32 const bit{ (j + 1) * 3 + (i + 1) };
+				size_t const lane{ n + static_cast<size_t>(i + 1) * count };
+				__m128i const fire{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(fire_rows[j + 1] + lane)) };
+				river = _mm_or_si128(river, _mm_loadu_si128(reinterpret_cast<__m128i const*>(river_rows[j + 1] + lane)));
+				awake = _mm_or_si128(awake, _mm_loadu_si128(reinterpret_cast<__m128i const*>(busy_rows[j + 1] + lane)));
+				if (water_mask >> bit & 1u)
+				{
+					__m128i const wet{ _mm_cmpgt_epi8(zero, fire) };
+					water_sum = _mm_add_epi8(water_sum, _mm_and_si128(fire, wet));
+					water_count = _mm_sub_epi8(water_count, wet);
+				}
+				__m128i const wind{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(fire_masks.data() + static_cast<size_t>(bit) * row_lanes + n)) };
+				__m128i const burning{ _mm_and_si128(_mm_cmpgt_epi8(fire, zero), wind) };
+				fire_sum = _mm_add_epi8(fire_sum, _mm_and_si128(fire, burning));
+				fire_count = _mm_sub_epi8(fire_count, burning);
+			}
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(band.fire_sum.data() + n), fire_sum);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(band.fire_count.data() + n), fire_count);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(band.water_sum.data() + n), water_sum);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(band.water_count.data() + n), water_count);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(band.near_river.data() + n), river);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(band.awake.data() + n), awake);
+	}
+#else
+	for (size_t n{ first }; n < last; ++n)
+	{
+		s8 fire_sum{}, fire_count{}, water_sum{}, water_count{};
+		u8 river{}, awake{};
+		for (s32 j{ -1 }; j < 2; ++j)
+		{
+			for (s32 i{ -1 }; i < 2; ++i)
+			{
+				s32 const bit{ (j + 1) * 3 + (i + 1) };
+				size_t const lane{ n + static_cast<size_t>(i + 1) * count };
+				s8 const fire{ fire_rows[j + 1][lane] };
+				river = static_cast<u8>(river | river_rows[j + 1][lane]);
+				awake = static_cast<u8>(awake | busy_rows[j + 1][lane]);
+				if ((water_mask >> bit & 1u) && fire < 0)
+				{
+					water_sum = static_cast<s8>(water_sum + fire);
+					++water_count;
+				}
+				if (fire > 0 && fire_masks[static_cast<size_t>(bit) * row_lanes + n])
+				{
+					fire_sum = static_cast<s8>(fire_sum + fire);
+					++fire_count;
+				}
+			}
+		}
+		band.fire_sum[n] = fire_sum;
+		band.fire_count[n] = fire_count;
+		band.water_sum[n] = water_sum;
+		band.water_count[n] = water_count;
+		band.near_river[n] = river;
+		band.awake[n] = awake;
+	}
+#endif
+}
+
+/**************************************************************************/
+/*!
+	 This function updates one band of the rows of this tick, every
+	 instance of a tile in turn with the Map's tile rules. An instance of a
+	 tile is only updated if a tile around it was busy in that instance
+	 last tick, the same tiles a Map updates. Rows that can change next
+	 tick are kept in the band and merged once the tick is done
+*/
+/**************************************************************************/
+void Batch_Simulation::Update_Band(s32 band_index, s32 band_count, bool fire_spread)
+{
+	Batch_Band& band = bands[band_index];
+	std::vector<Tiles> const& refer_grid = grids[current];
+	std::vector<Tiles>& display_grid = grids[1 - current];
+	std::vector<u8>& display_busy = busy_lanes[1 - current];
+	size_t const count{ static_cast<size_t>(instance_count) };
+	size_t const rows{ awake_rows.size() / 3 };
+	size_t const first{ rows * static_cast<size_t>(band_index) / static_cast<size_t>(band_count) };
+	size_t const last{ rows * static_cast<size_t>(band_index + 1) / static_cast<size_t>(band_count) };
+
+	for (size_t r{ first }; r < last; ++r)
+	{
+		s32 const y_value{ awake_rows[r * 3] };
+		s32 const x_first{ awake_rows[r * 3 + 1] };
+		s32 const x_last{ awake_rows[r * 3 + 2] };
+		Sum_Row(band, y_value, x_first, x_last);
+
+		s32 busy_first{ x_size };
+		s32 busy_last{ -1 };
+		for (s32 x_value{ x_first }; x_value <= x_last; ++x_value)
+		{
+			size_t const index{ Index(x_value, y_value) };
+			size_t const lane{ static_cast<size_t>(x_value) * count };
+			bool busy{};
+			for (size_t k{}; k < count; ++k)
+			{
+				if (band.awake[lane + k] == 0)
+				{
+					display_busy[index + k] = 0;
+					continue;
+				}
+				Batch_Instance const& instance = instances[k];
+				Tiles const refer{ refer_grid[index + k] };
+				// Like Map::Update_Tile, the update starts from the tile of the last tick
+				Tiles update{ refer };
+				Fire_Totals const totals{ band.fire_sum[lane + k], band.fire_count[lane + k], band.water_sum[lane + k],
+					band.water_count[lane + k], band.near_river[lane + k] != 0 };
+				rules.Fire_Behaviour(refer, update, totals, fire_spread, instance.house_durability != 0, band.trees_burnt[k], band.house_damage[k]);
+				if (fire_spread && refer.Get_Fire() <= 0 && update.Get_Fire() > 0 && !rules.Spread_Roll(instance.spread_roll, x_value, y_value))
+				{
+					update.Set_Fire(refer.Get_Fire());
+				}
+				rules.Earth_Behaviour(refer, update);
+				rules.State_Behaviour(update, instance.house_durability == 0);
+				display_grid[index + k] = update;
+				bool const lane_busy{ update != refer || update.Get_Fire() != 0 || (update.Get_Earth_Durability() > 0 && !update.Is_Earth_Permanant()) };
+				display_busy[index + k] = lane_busy;
+				busy = busy || lane_busy;
+			}
+			if (busy)
+			{
+				busy_first = std::min(busy_first, x_value);
+				busy_last = x_value;
+			}
+		}
+		if (busy_first <= busy_last)
+		{
+			band.busy.insert(band.busy.end(), { y_value, busy_first, busy_last });
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function advances every instance by one tick of BEHAVIOUR_TIME.
+	 Queued spells are applied first. The rows are split into bands across
+	 the thread pool, each tile only reads the grid of the last tick, so
+	 the result is the same for any number of bands
+*/
+/**************************************************************************/
+void Batch_Simulation::Simulate_Tick()
+{
+	if (instance_count <= 0)
+		return;
+
+	Apply_Commands();
+	bool const fire_spread{ fire_ticks_left <= 0 };
+	size_t const count{ static_cast<size_t>(instance_count) };
+
+	// Houses all turn to rubble once the house durability of an instance has run out
+	for (size_t k{}; k < count; ++k)
+	{
+		if (!instances[k].houses_left || instances[k].house_durability != 0)
+			continue;
+		for (s32 row : house_rows)
+		{
+			for (s32 x{}; x < x_size; ++x)
+			{
+				Wake_Lane(static_cast<s32>(k), x, row);
+			}
+		}
+	}
+
+	size_t tiles{};
+	awake_rows.clear();
+	for (s32 y{}; y < y_size; ++y)
+	{
+		if (span_first[y] > span_last[y])
+			continue;
+		awake_rows.insert(awake_rows.end(), { y, span_first[y], span_last[y] });
+		tiles += static_cast<size_t>(span_last[y] - span_first[y] + 1) * count;
+		span_first[y] = x_size;
+		span_last[y] = -1;
+	}
+
+	// The masks of every instance are repeated for every tile of a row, so a row is summed in one run
+	size_t const row_lanes{ static_cast<size_t>(stride) * count };
+	for (size_t k{}; k < count; ++k)
+	{
+		u16 const mask{ Get_Fire_Stencil_Mask(instances[k].wind_direction) };
+		for (s32 bit{}; bit < STENCIL_BITS; ++bit)
+		{
+			u8 const value{ static_cast<u8>((mask >> bit & 1u) ? 0xFF : 0) };
+			for (size_t lane{ static_cast<size_t>(bit) * row_lanes + k }; lane < static_cast<size_t>(bit + 1) * row_lanes; lane += count)
+			{
+				fire_masks[lane] = value;
+			}
+		}
+	}
+
+	// Small jobs are not worth waking the workers for
+	s32 band_count{ static_cast<s32>(std::min(tiles / MIN_BAND_TILES, static_cast<size_t>(thread_pool.Get_Thread_Count()))) };
+	band_count = std::max(std::min(band_count, static_cast<s32>(awake_rows.size() / 3)), 1);
+	bands.resize(static_cast<size_t>(band_count));
+	for (Batch_Band& band : bands)
+	{
+		size_t const lanes{ row_lanes + LANE_BLOCK };
+		if (band.fire_sum.size() != lanes)
+		{
+			for (s32 slot{}; slot < 3; ++slot)
+			{
+				band.fire_rows[slot].assign(lanes, 0);
+				band.river_rows[slot].assign(lanes, 0);
+			}
+			band.fire_sum.assign(lanes, 0);
+			band.fire_count.assign(lanes, 0);
+			band.water_sum.assign(lanes, 0);
+			band.water_count.assign(lanes, 0);
+			band.near_river.assign(lanes, 0);
+			band.awake.assign(lanes, 0);
+		}
+		band.trees_burnt.assign(count, 0);
+		band.house_damage.assign(count, 0);
+		band.busy.clear();
+		band.row = -2;
+	}
+
+	thread_pool.Run(band_count, [this, band_count, fire_spread](s32 band_index) { Update_Band(band_index, band_count, fire_spread); });
+	current = 1 - current;
+
+	for (size_t k{}; k < count; ++k)
+	{
+		Batch_Instance& instance = instances[k];
+		s32 house_damage{};
+		for (Batch_Band const& band : bands)
+		{
+			instance.tree_count -= band.trees_burnt[k];
+			house_damage += band.house_damage[k];
+		}
+		// Every house was updated with no durability left, none are left standing
+		if (instance.house_durability == 0)
+		{
+			instance.houses_left = false;
+		}
+		instance.house_durability = static_cast<s16>(std::max(instance.house_durability - house_damage, 0));
+		if (instance.wind_direction != Map::NO_WIND && --instance.wind_ticks <= 0)
+		{
+			instance.wind_direction = Map::NO_WIND;
+			instance.wind_ticks = 0;
+		}
+		instance.spread_roll += Map::SPREAD_ROLL_STEP;
+	}
+	for (Batch_Band const& band : bands)
+	{
+		for (size_t i{}; i < band.busy.size(); i += 3)
+		{
+			for (s32 j{ -1 }; j < 2; ++j)
+			{
+				Wake(band.busy[i] + j, band.busy[i + 1] - 1, band.busy[i + 2] + 1);
+			}
+		}
+	}
+
+	// Fire spreads on one tick out of every fire_spread_ticks
+	fire_ticks_left = fire_ticks_left <= 0 ? fire_spread_ticks - 1 : fire_ticks_left - 1;
+}
+
+/**************************************************************************/
+/*!
+	 This function runs tick_count ticks of every instance back to back
+*/
+/**************************************************************************/
+void Batch_Simulation::Run_Ticks(s32 tick_count)
+{
+	for (s32 i{}; i < tick_count; ++i)
+	{
+		Simulate_Tick();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of instances
+*/
+/**************************************************************************/
+s32 Batch_Simulation::Get_Instance_Count()
+{
+	return instance_count;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the width of the Map loaded
+*/
+/**************************************************************************/
+s32 Batch_Simulation::Get_X_Size()
+{
+	return x_size;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the height of the Map loaded
+*/
+/**************************************************************************/
+s32 Batch_Simulation::Get_Y_Size()
+{
+	return y_size;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to a tile of one instance as it is now, an empty
+	 tile outside the Map
+*/
+/**************************************************************************/
+Tiles Batch_Simulation::Get_Tile(s32 instance, s32 x_value, s32 y_value)
+{
+	if (instance < 0 || instance >= instance_count || x_value < 0 || y_value < 0 || x_value >= x_size || y_value >= y_size)
+		return Tiles{};
+	return grids[current][Index(x_value, y_value) + static_cast<size_t>(instance)];
+}
+
+/**************************************************************************/
+/*!
+	 This function counts the tiles burning in one instance
+*/
+/**************************************************************************/
+s32 Batch_Simulation::Count_Burning(s32 instance)
+{
+	if (instance < 0 || instance >= instance_count)
+		return 0;
+	s32 burning{};
+	for (s32 y{}; y < y_size; ++y)
+	{
+		for (s32 x{}; x < x_size; ++x)
+		{
+			burning += grids[current][Index(x, y) + static_cast<size_t>(instance)].Get_Fire() > 0;
+		}
+	}
+	return burning;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the tree count of one instance
+*/
+/**************************************************************************/
+s32 Batch_Simulation::Wood_Count(s32 instance)
+{
+	return instance >= 0 && instance < instance_count ? instances[static_cast<size_t>(instance)].tree_count : 0;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the house durability of one instance
+*/
+/**************************************************************************/
+s16 Batch_Simulation::Get_Curr_House_Durability(s32 instance)
+{
+	return instance >= 0 && instance < instance_count ? instances[static_cast<size_t>(instance)].house_durability : static_cast<s16>(0);
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the wind direction of one instance
+*/
+/**************************************************************************/
+u8 Batch_Simulation::Get_Wind(s32 instance)
+{
+	return instance >= 0 && instance < instance_count ? instances[static_cast<size_t>(instance)].wind_direction : static_cast<u8>(Map::NO_WIND);
+}
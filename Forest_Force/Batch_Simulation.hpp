@@ -0,0 +1,146 @@
+/******************************************************************************/
+/*!
+\file		Batch_Simulation.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Batch_Simulation class. A batch runs many
+			instances of one Map in lockstep, each with its own spells, wind
+			and spread rolls, for what-if work that plays the same level under
+			many different inputs.
+			The tiles of every instance are interleaved, the instances of one
+			tile sit next to each other. The fire/water stencil of a row is
+			summed for every instance in one pass, 16 byte lanes at a time
+			with SSE2, each lane with the wind shape of its own instance. The
+			tiles are then updated with the Map's own Fire_Behaviour,
+			Earth_Behaviour and State_Behaviour, so an instance plays out
+			exactly like a Map. Only the span of each row next to a tile that
+			was busy last tick in any instance is visited, and within it only
+			the instances that were busy around the tile are updated, the
+			same tiles each Map would update.
+			Define FIRE_STENCIL_NO_SIMD to build without the SSE2 kernel.
+			The main functions of Batch_Simulation.cpp are:
+			-Load
+				Starts every instance from a Map as it is now
+			-Queue_Command
+				Queues a spell for one instance, applied on the next tick
+			-Simulate_Tick
+				Advances every instance by one tick
+			-Get_Tile
+				A tile of one instance
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+#include "Map.hpp"
+
+// What one instance keeps besides its tiles, the same as a Map does
+struct Batch_Instance
+{
+	u8 wind_direction{};
+	s32 wind_ticks{};					// Ticks the wind still blows for
+	s16 house_durability{};
+	s32 tree_count{};
+	bool houses_left{};					// Houses still stand, they all change once durability runs out
+	u64 spread_roll{};					// Seed of this tick's spread rolls
+	std::vector<Map_Command> commands{};	// Spells for the next tick, in the order cast
+};
+
+// One band of the rows updated in a tick. Bands run on separate threads,
+// each with its own stencil rows and counters, merged once the tick is done.
+// Stencil rows hold the instances of a tile side by side, halo columns included.
+struct Batch_Band
+{
+	std::vector<s8> fire_rows[3]{};		// Fire of the rows above, at and below
+	std::vector<u8> river_rows[3]{};	// 0xFF where the tile is river
+	std::vector<s8> fire_sum{};
+	std::vector<s8> fire_count{};
+	std::vector<s8> water_sum{};
+	std::vector<s8> water_count{};
+	std::vector<u8> near_river{};
+	std::vector<u8> awake{};			// Not 0 if a tile around was busy last tick in that instance
+	s32 row{ -2 };						// Row the stencil rows are around
+	s32 x_first{};						// Span the stencil rows hold
+	s32 x_last{ -1 };
+	std::vector<s32> trees_burnt{};		// For every instance
+	std::vector<s32> house_damage{};	// For every instance
+	std::vector<s32> busy{};			// Row, first and last tile of rows that can change next tick
+};
+
+class Batch_Simulation
+{
+	Map rules{};						// Copy of the Map loaded from, its rule tables are used for every instance
+	s32 x_size{};
+	s32 y_size{};
+	s32 instance_count{};
+	s32 stride{};						// Tiles per row, halo included
+	std::vector<Tiles> grids[2]{};		// Tile (x, y) of instance k at Index(x, y) + k
+	std::vector<u8> busy_lanes[2]{};	// 1 where a tile of an instance can change the tiles around it, laid out like grids
+	s32 current{};						// Grid the last tick wrote
+	std::vector<Batch_Instance> instances{};
+	std::vector<Batch_Band> bands{};
+	std::vector<s32> span_first{};		// Tiles of each row to update next tick, none if first > last
+	std::vector<s32> span_last{};
+	std::vector<s32> awake_rows{};		// Rows updated this tick
+	std::vector<s32> house_rows{};		// Rows with houses, all updated once houses are destroyed
+	std::vector<u8> fire_masks{};		// 0xFF if an instance collects fire from a stencil bit, laid out like a stencil row for each bit
+	s32 fire_spread_ticks{ 1 };
+	s32 fire_ticks_left{};				// The same in every instance, they tick together
+
+	size_t Index(s32 x_value, s32 y_value) const
+	{
+		return (static_cast<size_t>(y_value + 1) * static_cast<size_t>(stride) + static_cast<size_t>(x_value + 1)) * static_cast<size_t>(instance_count);
+	}
+
+	void Wake(s32 y_value, s32 x_first, s32 x_last);
+
+	void Wake_Lane(s32 instance, s32 x_value, s32 y_value);
+
+	void Apply_Commands();
+
+	void Load_Row(Batch_Band& band, s32 slot, s32 y_value, s32 x_first, s32 x_last);
+
+	void Sum_Row(Batch_Band& band, s32 y_value, s32 x_first, s32 x_last);
+
+	void Update_Band(s32 band_index, s32 band_count, bool fire_spread);
+
+public:
+	Batch_Simulation() = default;
+	Batch_Simulation(Batch_Simulation const&) = delete;
+	Batch_Simulation& operator=(Batch_Simulation const&) = delete;
+	~Batch_Simulation();
+
+	bool Load(Map& source, s32 count);
+
+	void Unload();
+
+	void Queue_Command(s32 instance, u8 command, s32 x_value, s32 y_value, s8 value);
+
+	void Set_Spread_Chance(f32 chance);
+
+	void Set_Spread_Seed(s32 instance, u64 seed);
+
+	void Simulate_Tick();
+
+	void Run_Ticks(s32 tick_count);
+
+	s32 Get_Instance_Count();
+
+	s32 Get_X_Size();
+
+	s32 Get_Y_Size();
+
+	Tiles Get_Tile(s32 instance, s32 x_value, s32 y_value);
+
+	s32 Count_Burning(s32 instance);
+
+	s32 Wood_Count(s32 instance);
+
+	s16 Get_Curr_House_Durability(s32 instance);
+
+	u8 Get_Wind(s32 instance);
+};
@@ -147,7 +147,7 @@ void Camera_On_Player(const f32 &offset_x,const f32& offset_y)
 	
 	if(!fullscreen)
 	{
-		std::pair<s8, s8> temp{};
+		std::pair<s32, s32> temp{};
 		player.Get_Player_Tiles_Coordinates(temp.first, temp.second);
 
 		f32 border_offset = static_cast<f32>((GRID_SIZE) / 2.0f);
@@ -15,9 +15,11 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 
 #include "pch.hpp"
 #include "Click_Particle_System.hpp"
+#include "Random.hpp"
 
 static std::vector<Particle> click_particles;
 static size_t alive;
+static std::vector<f32> click_rolls;		// Random values of a spawn burst
 
 /**************************************************************************/
 /*!
@@ -37,24 +39,35 @@ void Click_Particles_Load() {
 */
 /**************************************************************************/
 void Click_Particles_Spawn(s32 mouseX, s32 mouseY, size_t numParticles) {
-	for (size_t i = 0; i < numParticles; ++i) {
-		if (alive < CLICK_PARTICLE_MAX_AMOUNT) {
-			Particle data = {};
-			data.x = static_cast<f32>(mouseX);
-			data.y = static_cast<f32>(mouseY);
-			data.vel_x = Random_Float(-CLICK_PARTICLE_VELOCITY, CLICK_PARTICLE_VELOCITY);
-			data.vel_y = Random_Float(-CLICK_PARTICLE_VELOCITY, CLICK_PARTICLE_VELOCITY);
-			data.lifetime = Random_Float(static_cast<float>(CLICK_PARTICLE_LIFETIME_MIN), static_cast<float>(CLICK_PARTICLE_LIFETIME_MAX));
-			data.scale_x = CLICK_PARTICLE_SCALE;
-			data.scale_y = CLICK_PARTICLE_SCALE;
-			data.rotation = Random_Float(0.0f, 2.0f * PI);
-			data.color_r = Random_Float(0.0f, 1.0f);
-			data.color_g = Random_Float(0.0f, 1.0f);
-			data.color_b = Random_Float(0.0f, 1.0f);
+	size_t spawn = std::min(numParticles, CLICK_PARTICLE_MAX_AMOUNT - alive);
 
-			++alive;
-			click_particles[alive - 1] = data;
-		}
+	// Roll the whole burst at once, one value range after another
+	click_rolls.resize(spawn * 7);
+	f32* vel = click_rolls.data();				// vel_x then vel_y
+	f32* lifetime = vel + spawn * 2;
+	f32* rotation = lifetime + spawn;
+	f32* color = rotation + spawn;				// r, g then b
+	Random& random = Thread_Random();
+	random.Fill_Range(vel, spawn * 2, -CLICK_PARTICLE_VELOCITY, CLICK_PARTICLE_VELOCITY);
+	random.Fill_Range(lifetime, spawn, static_cast<f32>(CLICK_PARTICLE_LIFETIME_MIN), static_cast<f32>(CLICK_PARTICLE_LIFETIME_MAX));
+	random.Fill_Range(rotation, spawn, 0.0f, 2.0f * PI);
+	random.Fill_Range(color, spawn * 3, 0.0f, 1.0f);
+
+	for (size_t i = 0; i < spawn; ++i) {
+		Particle data = {};
+		data.x = static_cast<f32>(mouseX);
+		data.y = static_cast<f32>(mouseY);
+		data.vel_x = vel[i];
+		data.vel_y = vel[spawn + i];
+		data.lifetime = lifetime[i];
+		data.scale_x = CLICK_PARTICLE_SCALE;
+		data.scale_y = CLICK_PARTICLE_SCALE;
+		data.rotation = rotation[i];
+		data.color_r = color[i];
+		data.color_g = color[spawn + i];
+		data.color_b = color[spawn * 2 + i];
+
+		click_particles[alive++] = data;
 	}
 }
 
@@ -28,9 +28,11 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Earth_Particle_System.hpp"
 #include "Map.hpp"
 #include "Player.hpp"
+#include "Random.hpp"
 
 static std::vector<Particle> earth_particles;
 static size_t earth_alive = 0;
+static std::vector<f32> earth_rolls;		// Random values of a spawn burst
 
 /**************************************************************************/
 /*!
@@ -49,24 +51,35 @@ void Earth_Particles_Load() {
 */
 /**************************************************************************/
 void Earth_Particles_Spawn(s32 tile_x, s32 tile_y) {
-	for (size_t i = 0; i < EARTH_PARTICLE_MAX_AMOUNT; ++i) {
-		if (earth_alive < EARTH_PARTICLE_MAX_AMOUNT) {
-			Particle data = {};
-			data.x = static_cast<f32>(tile_x) + Random_Float(-EARTH_PARTICLE_OFFSET_X, EARTH_PARTICLE_OFFSET_X);
-			data.y = static_cast<f32>(tile_y) + EARTH_PARTICLE_OFFSET_Y;
-			data.vel_x = Random_Float(-EARTH_PARTICLE_VELOCITY_X, EARTH_PARTICLE_VELOCITY_X);
-			data.vel_y = Random_Float(EARTH_PARTICLE_VELOCITY_Y_MIN, EARTH_PARTICLE_VELOCITY_Y_MAX);
-			data.lifetime = Random_Float(static_cast<float>(EARTH_PARTICLE_LIFETIME_MIN), static_cast<float>(EARTH_PARTICLE_LIFETIME_MAX));
-			data.scale_x = EARTH_PARTICLE_SCALE;
-			data.scale_y = EARTH_PARTICLE_SCALE;
-			data.rotation = 0;
-			data.color_r = 0.75f;
-			data.color_g = 0.6f;
-			data.color_b = 0.2f;
-
-			++earth_alive;
-			earth_particles[earth_alive - 1] = data;
-		}
+	size_t spawn = EARTH_PARTICLE_MAX_AMOUNT - earth_alive;
+
+	// Roll the whole burst at once, one value range after another
+	earth_rolls.resize(spawn * 4);
+	f32* offset_x = earth_rolls.data();
+	f32* vel_x = offset_x + spawn;
+	f32* vel_y = vel_x + spawn;
+	f32* lifetime = vel_y + spawn;
+	Random& random = Thread_Random();
+	random.Fill_Range(offset_x, spawn, -EARTH_PARTICLE_OFFSET_X, EARTH_PARTICLE_OFFSET_X);
+	random.Fill_Range(vel_x, spawn, -EARTH_PARTICLE_VELOCITY_X, EARTH_PARTICLE_VELOCITY_X);
+	random.Fill_Range(vel_y, spawn, EARTH_PARTICLE_VELOCITY_Y_MIN, EARTH_PARTICLE_VELOCITY_Y_MAX);
+	random.Fill_Range(lifetime, spawn, static_cast<f32>(EARTH_PARTICLE_LIFETIME_MIN), static_cast<f32>(EARTH_PARTICLE_LIFETIME_MAX));
+
+	for (size_t i = 0; i < spawn; ++i) {
+		Particle data = {};
+		data.x = static_cast<f32>(tile_x) + offset_x[i];
+		data.y = static_cast<f32>(tile_y) + EARTH_PARTICLE_OFFSET_Y;
+		data.vel_x = vel_x[i];
+		data.vel_y = vel_y[i];
+		data.lifetime = lifetime[i];
+		data.scale_x = EARTH_PARTICLE_SCALE;
+		data.scale_y = EARTH_PARTICLE_SCALE;
+		data.rotation = 0;
+		data.color_r = 0.75f;
+		data.color_g = 0.6f;
+		data.color_b = 0.2f;
+
+		earth_particles[earth_alive++] = data;
 	}
 }
 
@@ -17,6 +17,8 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 /******************************************************************************/
 #include "pch.hpp"
 #include "File_Load.hpp"
+#include "Map.hpp"						// Tiles, for the range of its fire field
+#include <algorithm>					// std::clamp
 
 static const std::string GAME_DATA_FILE_PATH = "Data/Game/";
 
@@ -36,6 +38,8 @@ s8 PLAYER_AIR_RANGE{};
 // For Map.cpp
 f64 WIND_TIMER{};
 f64 BEHAVIOUR_TIME{};
+s32 MAX_TICKS_PER_FRAME{ 4 };
+f64 REWIND_TIME{ 10.0 };
 s8 MAX_FIRE_VALUE{};
 s8 MAX_WATER_VALUE{};
 s8 WATER_STRENGTH_MULTIPLER{};
@@ -43,6 +47,16 @@ s8 MAX_EARTH_DURABILTY{};
 s8 MAX_WOOD_DURABILTY{};
 s16 MAX_HOUSE_DURABILTY{};
 
+// For Risk_Map.cpp
+f64 RISK_TIME{ 4.0 };
+f32 RISK_SPREAD_CHANCE{ 0.6f };
+s32 RISK_RUNS{ 256 };
+f64 RISK_BUDGET{ 0.004 };
+
+// For Solver.cpp
+f64 SOLVE_TIME{ 2.0 };
+f64 SOLVE_HORIZON{ 240.0 };
+
 // For Click_Particle_System.cpp
 size_t CLICK_PARTICLE_MAX_AMOUNT{};
 size_t CLICK_PARTICLE_SPAWN_ONCLICK{};
@@ -171,9 +185,10 @@ void Load_Map_Parameters()
 		input_file >> param_name >> param_value;
 		BEHAVIOUR_TIME = static_cast<f64>(std::stod(param_value));
 		input_file >> param_name >> param_value;
-		MAX_FIRE_VALUE = static_cast<s8>(std::stoi(param_value));
+		// Fire and water share the 5 bit signed fire field of a tile, from -16 to 15
+		MAX_FIRE_VALUE = static_cast<s8>(std::clamp(std::stoi(param_value), 0, static_cast<s32>(Tiles::FIRE_SIGN) - 1));
 		input_file >> param_name >> param_value;
-		MAX_WATER_VALUE = static_cast<s8>(std::stoi(param_value));
+		MAX_WATER_VALUE = static_cast<s8>(std::clamp(std::stoi(param_value), 0, static_cast<s32>(Tiles::FIRE_SIGN)));
 		input_file >> param_name >> param_value;
 		WATER_STRENGTH_MULTIPLER = static_cast<s8>(std::stoi(param_value));
 		input_file >> param_name >> param_value;
@@ -182,6 +197,23 @@ void Load_Map_Parameters()
 		MAX_WOOD_DURABILTY = static_cast<s8>(std::stoi(param_value));
 		input_file >> param_name >> param_value;
 		MAX_HOUSE_DURABILTY = static_cast<s16>(std::stoi(param_value));
+		// Older Map.txt files stop here and keep the default
+		if (input_file >> param_name >> param_value)
+			MAX_TICKS_PER_FRAME = static_cast<s32>(std::stoi(param_value));
+		if (input_file >> param_name >> param_value)
+			REWIND_TIME = static_cast<f64>(std::stod(param_value));
+		if (input_file >> param_name >> param_value)
+			RISK_TIME = static_cast<f64>(std::stod(param_value));
+		if (input_file >> param_name >> param_value)
+			RISK_SPREAD_CHANCE = static_cast<f32>(std::stod(param_value));
+		if (input_file >> param_name >> param_value)
+			RISK_RUNS = static_cast<s32>(std::stoi(param_value));
+		if (input_file >> param_name >> param_value)
+			RISK_BUDGET = static_cast<f64>(std::stod(param_value));
+		if (input_file >> param_name >> param_value)
+			SOLVE_TIME = static_cast<f64>(std::stod(param_value));
+		if (input_file >> param_name >> param_value)
+			SOLVE_HORIZON = static_cast<f64>(std::stod(param_value));
 	}
 	input_file.close();
 }
@@ -44,18 +44,9 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 /******************************************************************************/
 #include "pch.hpp"
 #include "Fileio.hpp"
-#include "Map.hpp"
-#include "Player.hpp"
-#include "Objectives.hpp"
+#include "World.hpp"
 #include "Level_Editor.hpp"
 
-// Used for Loading Objectives
-static std::vector<std::string> obj;
-static std::vector<std::string> obj_param;
-
-// Store the tile stats into the a 2D vector
-static std::vector <std::vector < Tile_Stats > > Tile_Vector;
-
 // List of keyphrases the function Read_File() to catch
 static std::vector<std::string> Game_Object_Stats{ "Width :" ,"Height :" ,"Player X :" , "Player Y :" , "Objectives :" , "Weather :" };
 
@@ -105,7 +96,7 @@ namespace {
 	}
 
 	// Split / Splice the string under Objectives 
-	void Split_Objectives_String(std::string const& objtive_str)
+	void Split_Objectives_String(std::string const& objtive_str, std::vector<std::string>& obj, std::vector<std::string>& obj_param)
 	{
 		std::string current_str;
 
@@ -140,10 +131,10 @@ namespace {
 				objective_string << "EM " << 0 << " ";
 				break;
 			case(Objectives::CATCH_ARSONIST):
-				objective_string << "CA " << static_cast<s32>(obj_list.arsonist_coord.first) << "," << static_cast<s32>(obj_list.arsonist_coord.second) << " ";
+				objective_string << "CA " << obj_list.arsonist_coord.first << "," << obj_list.arsonist_coord.second << " ";
 				break;
 			case(Objectives::SAVE_HOUSE):
-				objective_string << "SH " << static_cast<s32>(obj_list.house_coord.first) << "," << static_cast<s32>(obj_list.house_coord.second) << " ";
+				objective_string << "SH " << obj_list.house_coord.first << "," << obj_list.house_coord.second << " ";
 				break;
 			case(Objectives::TIME_LIMIT):
 				objective_string << "TL " << obj_list.time_limit << " ";
@@ -166,18 +157,25 @@ namespace {
 	}
 }
 
-// Read .txt file from the Assets folder via the specified file name
-int Read_File(std::string const& filename)
+// Read .txt file from the Assets folder via the specified file name into the world
+int Read_File(std::string const& filename, World& world)
 {
-	s8 player_x{}, player_y{};
+	s32 size_x{}, size_y{};
+	s32 player_x{}, player_y{};
 	s8 weather_value{};
 	size_t num_pos;
 	std::string num_string;
 
+	// Used for Loading Objectives
+	std::vector<std::string> obj;
+	std::vector<std::string> obj_param;
+
+	// Store the tile stats into the a 2D vector
+	std::vector <std::vector < Tile_Stats > > Tile_Vector;
+
 	std::fstream open_level_file(filename, std::ios_base::in);
 	if (!open_level_file.is_open())
 	{
-		next = GS_QUIT;
 		return 0;
 	}
 
@@ -192,31 +190,31 @@ int Read_File(std::string const& filename)
 
 		// Now check each line
 		// If the line contains "Width : "
-		// Assign the value to TILE_X
+		// Assign the value to size_x
 		if (Game_Object_Stats[i] == "Width :")
 		{
-			TILE_X = static_cast<s8>(std::stoi(num_string));
+			size_x = std::stoi(num_string);
 		}
 
 		// If the line contains "Height : "
-		// Assign the value to TILE_Y
+		// Assign the value to size_y
 		else if (Game_Object_Stats[i] == "Height :")
 		{
-			TILE_Y = static_cast<s8>(std::stoi(num_string));
+			size_y = std::stoi(num_string);
 		}
 
 		// If the line contains "Player X : "
 		// Assign the value to player_x
 		else if (Game_Object_Stats[i] == "Player X :")
 		{
-			player_x = static_cast<s8>(std::stoi(num_string));
+			player_x = std::stoi(num_string);
 		}
 
 		// If the line contains "Player Y : "
 		// Assign the value to player_y
 		else if (Game_Object_Stats[i] == "Player Y :")
 		{
-			player_y = static_cast<s8>(std::stoi(num_string));
+			player_y = std::stoi(num_string);
 		}
 
 		// If the line contains "Objectives : "
@@ -230,7 +228,7 @@ int Read_File(std::string const& filename)
 			// Into the three objectives
 			obj.clear();
 			obj_param.clear();
-			Split_Objectives_String(objtive_string);
+			Split_Objectives_String(objtive_string, obj, obj_param);
 		}
 
 		else if (Game_Object_Stats[i] == "Weather :")
@@ -241,12 +239,12 @@ int Read_File(std::string const& filename)
 	}
 
 	// Initializing the tile vector first
-	Tile_Vector.resize(TILE_X);
+	Tile_Vector.resize(size_x);
 
-	for (s8 i{}; i < TILE_X; ++i)
+	for (s32 i{}; i < size_x; ++i)
 	{
-		Tile_Vector[i] = std::vector <Tile_Stats>(TILE_Y);
-		for (s8 j{}; j < TILE_Y; ++j)
+		Tile_Vector[i] = std::vector <Tile_Stats>(size_y);
+		for (s32 j{}; j < size_y; ++j)
 		{
 			Tile_Vector[i][j].type_value = 0;
 			Tile_Vector[i][j].terrain_value = 0;
@@ -256,9 +254,9 @@ int Read_File(std::string const& filename)
 	std::vector<Fire_List> fire_list;
 
 	// Now set the values from the tile vector
-	for (s8 i = (TILE_Y - 1); i >= 0; --i)
+	for (s32 i = (size_y - 1); i >= 0; --i)
 	{
-		for (s8 j{}; j < TILE_X; ++j)
+		for (s32 j{}; j < size_x; ++j)
 		{
 			s64 cell_values;
 			open_level_file >> cell_values;
@@ -272,28 +270,28 @@ int Read_File(std::string const& filename)
 		}
 	}
 
-	// Now call Map_Load with TILE_X and TILE_Y as parameters
-	level_map.Map_Load(TILE_X, TILE_Y);
+	// Now call Map_Load with size_x and size_y as parameters
+	world.map.Map_Load(size_x, size_y);
 
-	for (s8 y = (TILE_Y - 1); y >= 0; --y)
+	for (s32 y = (size_y - 1); y >= 0; --y)
 	{
-		for (s8 x{}; x < TILE_X; ++x)
+		for (s32 x{}; x < size_x; ++x)
 		{
-			level_map.Tile_Init(Find_Tile_Type(Tile_Vector[x][y].type_value), x, y, Find_Terrain_Value(Tile_Vector[x][y].terrain_value));
+			world.map.Tile_Init(Find_Tile_Type(Tile_Vector[x][y].type_value), x, y, Find_Terrain_Value(Tile_Vector[x][y].terrain_value));
 		}
 	}
 	
 	// Call Set_Init_Fire and set the fire's x and y positions as well as strength
 	for (size_t i{}; i < fire_list.size(); ++i)
 	{
-		level_map.Set_Init_Fire(fire_list[i].fire_x, fire_list[i].fire_y, fire_list[i].fire_strength);
+		world.map.Set_Init_Fire(fire_list[i].fire_x, fire_list[i].fire_y, fire_list[i].fire_strength);
 	}
-	level_map.Weather_Init(weather_value);
+	world.map.Weather_Init(weather_value);
 	// Call Load member function from player to set the player's initial position
-	player.Load(player_x, player_y);
+	world.player.Load(player_x, player_y);
 
 	// Call Load member function from objectives to set the objectives of the level
-	objectives.Load(Find_Objective(obj[0]), obj_param[0], Find_Objective(obj[1]), obj_param[1], Find_Objective(obj[2]), obj_param[2]);
+	world.objectives.Load(Find_Objective(obj[0]), obj_param[0], Find_Objective(obj[1]), obj_param[1], Find_Objective(obj[2]), obj_param[2]);
 
 	//Close file stream
 	open_level_file.close();
@@ -301,12 +299,17 @@ int Read_File(std::string const& filename)
 	return 1;
 }
 
+// Return the level file the level editor saves to (the user generated level)
+std::string Editor_Level_File()
+{
+	return "Data/Levels/level" + std::to_string(LAST_LEVEL - GS_LEVEL1 + 1) + ".txt";
+}
+
 // Write data collected from level editor to a .txt file
 int Write_File(Tiles **Created_Grid, Game_object_Stats game_obj_stats, std::vector<u8> const& objective_list, Editor_Objectives const& editor_obj ,s8 weather)
 {
 	// write data into file level7.txt (user generated level)
-	std::string level = "Data/Levels/level";
-	level += std::to_string(LAST_LEVEL - GS_LEVEL1 + 1) + ".txt";
+	std::string level = Editor_Level_File();
 	std::fstream write_level_file(level.c_str(), std::ios_base::out);
 	
 	// Check if can write into a .txt file
@@ -316,20 +319,20 @@ int Write_File(Tiles **Created_Grid, Game_object_Stats game_obj_stats, std::vect
 	}
 
 	// Write into ofstream the first 5 necessary stats
-	write_level_file << "Width : " << static_cast<s32>(TILE_X) << '\n';
-	write_level_file << "Height : " << static_cast<s32>(TILE_Y) << '\n';
-	write_level_file << "Player X : " << static_cast<s32>(game_obj_stats.player_x) << '\n';
-	write_level_file << "Player Y : " << static_cast<s32>(game_obj_stats.player_y) << '\n';
+	write_level_file << "Width : " << TILE_X << '\n';
+	write_level_file << "Height : " << TILE_Y << '\n';
+	write_level_file << "Player X : " << game_obj_stats.player_x << '\n';
+	write_level_file << "Player Y : " << game_obj_stats.player_y << '\n';
 	write_level_file << "Objectives : " << Create_Objective_String(objective_list, editor_obj) << "\n";
 	write_level_file << "Weather : " << static_cast<s32>(weather) << "\n";
 
-	for (s8 y = (TILE_Y - 1); y >= 0; --y)
+	for (s32 y = (TILE_Y - 1); y >= 0; --y)
 	{
-		for (s8 x{}; x < TILE_X; ++x)
+		for (s32 x{}; x < TILE_X; ++x)
 		{
 
 			// Call to Concat_Cell_Stats to concatenate the three values 
-			std::string cell_stats = Concat_Cell_Stats(Created_Grid[y][x].tile_type, Created_Grid[y][x].terrain_type, Created_Grid[y][x].fire);
+			std::string cell_stats = Concat_Cell_Stats(Created_Grid[y][x].Get_Tile_Type(), Created_Grid[y][x].Get_Terrain_Type(), Created_Grid[y][x].Get_Fire());
 
 			// Now insert the value in cell_stats into the file stream
 			write_level_file << cell_stats << " ";
@@ -8,6 +8,7 @@
 \brief		This file contains the header for the File Input / Output code.
 			This file contains the declaration / prototype of the functions
 			Read_File() and Write_File()
+			and the name of the file Write_File() saves to, Editor_Level_File()
 
 			This file also contains the struct the represents the data to be
 			included in each tile
@@ -33,11 +34,15 @@ struct Tile_Stats {
 };
 
 struct Fire_List {
-	s8 fire_x;
-	s8 fire_y;
+	s32 fire_x;
+	s32 fire_y;
 	s8 fire_strength;
 };
 
-int Read_File(std::string const& filename);
+class World;
+
+int Read_File(std::string const& filename, World& world);
+
+std::string Editor_Level_File();
 
 int Write_File(Tiles** Created_Grid, Game_object_Stats game_obj_stats, std::vector<u8> const& objective_list, Editor_Objectives const& editor_obj, s8 weather);
\ No newline at end of file
@@ -0,0 +1,485 @@
+/******************************************************************************/
+/*!
+\file		Fire_Arrival.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the fire arrival field, an estimate of how many
+			ticks fire needs to reach every tile of the Map. Fire travels from
+			the burning tiles along the shape the wind gives the fire stencil,
+			one step every fire spread tick. It keeps its heat on fuel (wood and
+			standing houses) and loses one heat a step on bare ground, and
+			never crosses river, hills, mountains, earth or water.
+			The field is a shortest path tree grown from the burning tiles.
+			After a tick only the tiles the tick updated are checked, and only
+			the parts of the tree that hang off a tile that changed are grown
+			again, so the cost follows the fire front and not the Map.
+			The main functions of Fire_Arrival.cpp are:
+			-Rebuild
+				Grows the whole field from the burning tiles
+			-Update
+				Repairs the field after a tick from the tiles it updated
+			-Get_Ticks
+				Ticks until fire is expected on a tile
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Fire_Arrival.hpp"
+#include "Map.hpp"
+#include <algorithm>					// std::push_heap, std::pop_heap
+#include <functional>					// std::greater
+
+namespace
+{
+	// Tile classes, bits 0-1 of a tile kind
+	const u8 BLOCKED{ 0 };				// Fire never reaches it
+	const u8 BARE{ 1 };					// Fire crosses it losing heat
+	const u8 FUEL{ 2 };					// Fire crosses it at full heat
+	const u8 CLASS_MASK{ 3 };
+	const u8 BURNING{ 4 };
+	const u8 HEAT_SHIFT{ 3 };			// Heat of a burning bare tile
+
+	const s32 NO_PARENT{ -1 };
+	const s32 ROOT{ -2 };				// A burning tile, fire starts from it
+
+	/**************************************************************************/
+	/*!
+		Returns if fire blown by the wind moves x_offset, y_offset tiles in
+		one step, the mirror of the tiles the wind shaped stencil reads
+	*/
+	/**************************************************************************/
+	bool In_Wind(u8 wind_direction, s32 x_offset, s32 y_offset)
+	{
+		switch (wind_direction)
+		{
+		case(Map::UP):
+			return y_offset == 1;
+		case(Map::DOWN):
+			return y_offset == -1;
+		case(Map::LEFT):
+			return x_offset == -1;
+		case(Map::RIGHT):
+			return x_offset == 1;
+		default:
+			return false;
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function sizes the field for a Map of x_value by y_value tiles,
+	 the field is grown again on the next Update
+*/
+/**************************************************************************/
+void Fire_Arrival::Resize(s32 x_value, s32 y_value)
+{
+	x_size = x_value;
+	y_size = y_value;
+	layers = std::max(static_cast<s32>(MAX_FIRE_VALUE), 1);
+	size_t tiles{ static_cast<size_t>(x_size) * static_cast<size_t>(y_size) };
+	arrival.assign(tiles * static_cast<size_t>(layers), UNREACHABLE);
+	parent.assign(tiles * static_cast<size_t>(layers), NO_PARENT);
+	kind.assign(tiles, BLOCKED);
+	built = false;
+}
+
+/**************************************************************************/
+/*!
+	 This function drops the field, when the Map has jumped to a state it
+	 was not grown for. It is grown again on the next Update
+*/
+/**************************************************************************/
+void Fire_Arrival::Clear()
+{
+	built = false;
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the class of a tile for fire to travel over,
+	 with the burning bit and the heat of burning bare ground
+*/
+/**************************************************************************/
+u8 Fire_Arrival::Tile_Kind(Tile_Grid const& grid, s32 tile) const
+{
+	Tiles const& value = grid[tile / x_size][tile % x_size];
+	s8 fire{ value.Get_Fire() };
+	if (value.Get_Tile_Type() == Map::RIVER || value.Get_Terrain_Type() >= Map::HILL || value.Get_Earth_Durability() > 0 || fire < 0)
+		return BLOCKED;
+
+	bool fuel{ value.Get_Wood_Durability() > 0 || (value.Get_Terrain_Type() == Map::HOUSE && houses_standing) };
+	if (fire <= 0)
+		return fuel ? FUEL : BARE;
+	if (fuel)
+		return static_cast<u8>(FUEL | BURNING);
+	s32 heat{ std::min(static_cast<s32>(fire), layers) };
+	return static_cast<u8>(BARE | BURNING | (heat << HEAT_SHIFT));
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the first tick from tick on that fire spreads
+*/
+/**************************************************************************/
+s32 Fire_Arrival::Next_Spread(s32 tick) const
+{
+	return tick + ((phase - tick) % spread_ticks + spread_ticks) % spread_ticks;
+}
+
+/**************************************************************************/
+/*!
+	 This function returns when fire that reached a tile at from_arrival
+	 reaches its neighbour x_offset, y_offset away. It spreads with the wind
+	 while the wind blows and in a + shape once it has stopped
+*/
+/**************************************************************************/
+s32 Fire_Arrival::Spread_Arrival(s32 from_arrival, s32 x_offset, s32 y_offset) const
+{
+	s32 base{ std::max(from_arrival, now) };
+	bool plus{ (x_offset == 0) != (y_offset == 0) };
+	if (wind_direction != Map::NO_WIND && base < wind_end)
+	{
+		s32 best{ UNREACHABLE };
+		s32 tick{ Next_Spread(base) };
+		if (tick < wind_end && In_Wind(wind_direction, x_offset, y_offset))
+		{
+			best = tick + 1;
+		}
+		if (plus)
+		{
+			best = std::min(best, Next_Spread(wind_end) + 1);
+		}
+		return best;
+	}
+	return plus ? Next_Spread(base) + 1 : UNREACHABLE;
+}
+
+/**************************************************************************/
+/*!
+	 This function makes a burning tile a starting point of the fire
+*/
+/**************************************************************************/
+void Fire_Arrival::Set_Root(s32 tile, s32 layer, s32 tick)
+{
+	s32 node{ tile * layers + layer };
+	arrival[node] = tick;
+	parent[node] = ROOT;
+	heap.emplace_back(tick, node);
+	std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<s32, s32>>{});
+}
+
+/**************************************************************************/
+/*!
+	 This function clears every node of a tile and every node the fire
+	 reached through them. The tile is grown again even if fire did not
+	 reach it before, it may have become something fire crosses
+*/
+/**************************************************************************/
+void Fire_Arrival::Invalidate_Tile(s32 tile)
+{
+	for (s32 layer{}; layer < layers; ++layer)
+	{
+		Invalidate(tile * layers + layer);
+		invalid.push_back(tile * layers + layer);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function clears a node and every node the fire reached through
+	 it
+*/
+/**************************************************************************/
+void Fire_Arrival::Invalidate(s32 first_node)
+{
+	stack.push_back(first_node);
+	while (!stack.empty())
+	{
+		s32 node{ stack.back() };
+		stack.pop_back();
+		if (arrival[node] == UNREACHABLE && parent[node] == NO_PARENT)
+			continue;
+		arrival[node] = UNREACHABLE;
+		parent[node] = NO_PARENT;
+		invalid.push_back(node);
+
+		s32 x_value{ node / layers % x_size };
+		s32 y_value{ node / layers / x_size };
+		for (s32 j{ std::max(y_value - 1, 0) }; j <= std::min(y_value + 1, y_size - 1); ++j)
+		{
+			for (s32 i{ std::max(x_value - 1, 0) }; i <= std::min(x_value + 1, x_size - 1); ++i)
+			{
+				s32 neighbour{ (j * x_size + i) * layers };
+				for (s32 layer{}; layer < layers; ++layer)
+				{
+					if (parent[neighbour + layer] == node)
+					{
+						stack.push_back(neighbour + layer);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function finds the earliest fire reaching a cleared node from
+	 the nodes around it that still hold fire or will
+*/
+/**************************************************************************/
+void Fire_Arrival::Regrow(s32 node)
+{
+	s32 tile{ node / layers };
+	s32 layer{ node % layers };
+	u8 tile_kind{ kind[tile] };
+	u8 tile_class{ static_cast<u8>(tile_kind & CLASS_MASK) };
+	if (tile_class == BLOCKED || (tile_kind & BURNING) || (tile_class == FUEL && layer != 0) || (tile_class == BARE && layer == 0))
+		return;
+
+	s32 x_value{ tile % x_size };
+	s32 y_value{ tile / x_size };
+	for (s32 j{ std::max(y_value - 1, 0) }; j <= std::min(y_value + 1, y_size - 1); ++j)
+	{
+		for (s32 i{ std::max(x_value - 1, 0) }; i <= std::min(x_value + 1, x_size - 1); ++i)
+		{
+			s32 from_tile{ j * x_size + i };
+			if (from_tile == tile)
+				continue;
+			// Fuel is reached at full heat from any heat, bare ground one heat lower
+			s32 first{ tile_class == FUEL ? 0 : layer - 1 };
+			s32 last{ tile_class == FUEL ? layers - 1 : layer - 1 };
+			for (s32 from_layer{ first }; from_layer <= last; ++from_layer)
+			{
+				s32 from_node{ from_tile * layers + from_layer };
+				s32 from_arrival{ arrival[from_node] };
+				if (from_arrival == UNREACHABLE || (from_arrival <= now && !(kind[from_tile] & BURNING)))
+					continue;
+				s32 candidate{ Spread_Arrival(from_arrival, x_value - i, y_value - j) };
+				if (candidate < arrival[node])
+				{
+					arrival[node] = candidate;
+					parent[node] = from_node;
+				}
+			}
+		}
+	}
+	if (arrival[node] != UNREACHABLE)
+	{
+		heap.emplace_back(arrival[node], node);
+		std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<s32, s32>>{});
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function checks a tile the last tick updated against what the
+	 field expected of it, and clears what no longer holds
+*/
+/**************************************************************************/
+void Fire_Arrival::Check_Tile(Tile_Grid const& grid, s32 tile)
+{
+	u8 old_kind{ kind[tile] };
+	u8 new_kind{ Tile_Kind(grid, tile) };
+	kind[tile] = new_kind;
+
+	if (new_kind & BURNING)
+	{
+		s32 root_layer{ (new_kind & CLASS_MASK) == FUEL ? 0 : layers - (new_kind >> HEAT_SHIFT) };
+		s32 node{ tile * layers + root_layer };
+		if (old_kind == new_kind && parent[node] == ROOT)
+			return;
+		// Caught fire as expected, what was grown from it still holds
+		if (arrival[node] <= now && parent[node] != NO_PARENT)
+		{
+			for (s32 layer{}; layer < layers; ++layer)
+			{
+				if (layer != root_layer)
+				{
+					Invalidate(tile * layers + layer);
+				}
+			}
+			parent[node] = ROOT;
+			return;
+		}
+		Invalidate_Tile(tile);
+		Set_Root(tile, root_layer, now);
+		return;
+	}
+
+	bool overdue{ false };
+	for (s32 layer{}; layer < layers; ++layer)
+	{
+		overdue = overdue || arrival[tile * layers + layer] <= now;
+	}
+	if (old_kind != new_kind || overdue)
+	{
+		Invalidate_Tile(tile);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function grows the fire from the nodes in the heap, earliest
+	 first, until no node can be reached any sooner
+*/
+/**************************************************************************/
+void Fire_Arrival::Grow()
+{
+	while (!heap.empty())
+	{
+		std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<s32, s32>>{});
+		std::pair<s32, s32> top{ heap.back() };
+		heap.pop_back();
+		s32 node{ top.second };
+		if (top.first != arrival[node])
+			continue;
+		s32 tile{ node / layers };
+		s32 layer{ node % layers };
+		// Fire that came and went does not spread again
+		if (top.first <= now && !(kind[tile] & BURNING))
+			continue;
+
+		s32 x_value{ tile % x_size };
+		s32 y_value{ tile / x_size };
+		for (s32 j{ std::max(y_value - 1, 0) }; j <= std::min(y_value + 1, y_size - 1); ++j)
+		{
+			for (s32 i{ std::max(x_value - 1, 0) }; i <= std::min(x_value + 1, x_size - 1); ++i)
+			{
+				s32 to_tile{ j * x_size + i };
+				u8 to_kind{ kind[to_tile] };
+				u8 to_class{ static_cast<u8>(to_kind & CLASS_MASK) };
+				if (to_tile == tile || to_class == BLOCKED || (to_kind & BURNING))
+					continue;
+				s32 to_layer{ to_class == FUEL ? 0 : layer + 1 };
+				if (to_layer >= layers)
+					continue;
+				s32 candidate{ Spread_Arrival(top.first, i - x_value, j - y_value) };
+				s32 to_node{ to_tile * layers + to_layer };
+				if (candidate < arrival[to_node])
+				{
+					arrival[to_node] = candidate;
+					parent[to_node] = node;
+					heap.emplace_back(candidate, to_node);
+					std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<s32, s32>>{});
+				}
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function grows the whole field from the burning tiles of grid
+*/
+/**************************************************************************/
+void Fire_Arrival::Rebuild(Tile_Grid const& grid, Fire_Conditions const& conditions)
+{
+	now = 0;
+	spread_ticks = std::max(conditions.spread_ticks, 1);
+	phase = std::max(conditions.ticks_to_spread, 0) % spread_ticks;
+	wind_direction = conditions.wind_direction;
+	wind_end = conditions.wind_direction != Map::NO_WIND ? conditions.wind_ticks : 0;
+	houses_standing = conditions.houses_standing;
+
+	std::fill(arrival.begin(), arrival.end(), UNREACHABLE);
+	std::fill(parent.begin(), parent.end(), NO_PARENT);
+	heap.clear();
+	s32 tiles{ x_size * y_size };
+	for (s32 tile{}; tile < tiles; ++tile)
+	{
+		kind[tile] = Tile_Kind(grid, tile);
+		if (kind[tile] & BURNING)
+		{
+			Set_Root(tile, (kind[tile] & CLASS_MASK) == FUEL ? 0 : layers - (kind[tile] >> HEAT_SHIFT), 0);
+		}
+	}
+	Grow();
+	built = true;
+}
+
+/**************************************************************************/
+/*!
+	 This function repairs the field after a tick. updated_tiles are the
+	 tiles the tick updated, nullptr if it updated every tile. A change of
+	 wind, spread timing or houses standing grows the field again instead
+*/
+/**************************************************************************/
+void Fire_Arrival::Update(Tile_Grid const& grid, std::vector<s32> const* updated_tiles, Fire_Conditions const& conditions)
+{
+	if (!built)
+	{
+		Rebuild(grid, conditions);
+		return;
+	}
+
+	++now;
+	bool wind_blowing{ wind_direction != Map::NO_WIND && now < wind_end };
+	bool same_wind{ wind_blowing ? conditions.wind_direction == wind_direction && now + conditions.wind_ticks == wind_end
+		: conditions.wind_direction == Map::NO_WIND };
+	bool same_spread{ conditions.spread_ticks == spread_ticks && (now + std::max(conditions.ticks_to_spread, 0)) % spread_ticks == phase };
+	if (!same_wind || !same_spread || conditions.houses_standing != houses_standing)
+	{
+		Rebuild(grid, conditions);
+		return;
+	}
+
+	invalid.clear();
+	if (updated_tiles)
+	{
+		for (s32 tile : *updated_tiles)
+		{
+			Check_Tile(grid, tile);
+		}
+	}
+	else
+	{
+		s32 tiles{ x_size * y_size };
+		for (s32 tile{}; tile < tiles; ++tile)
+		{
+			Check_Tile(grid, tile);
+		}
+	}
+	for (s32 node : invalid)
+	{
+		if (arrival[node] == UNREACHABLE)
+		{
+			Regrow(node);
+		}
+	}
+	Grow();
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to whether the field has been grown
+*/
+/**************************************************************************/
+bool Fire_Arrival::Is_Built() const
+{
+	return built;
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the ticks until fire is expected on a tile, 0
+	 if it is burning and -1 if fire is not expected to reach it
+*/
+/**************************************************************************/
+s32 Fire_Arrival::Get_Ticks(s32 x_value, s32 y_value) const
+{
+	if (!built || x_value < 0 || y_value < 0 || x_value >= x_size || y_value >= y_size)
+		return -1;
+	s32 best{ UNREACHABLE };
+	s32 first{ (y_value * x_size + x_value) * layers };
+	for (s32 layer{}; layer < layers; ++layer)
+	{
+		best = std::min(best, arrival[first + layer]);
+	}
+	return best == UNREACHABLE ? -1 : std::max(best - now, 0);
+}
@@ -0,0 +1,97 @@
+/******************************************************************************/
+/*!
+\file		Fire_Arrival.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the fire arrival field, an estimate of how many
+			ticks fire needs to reach every tile of the Map. Fire travels from
+			the burning tiles along the shape the wind gives the fire stencil,
+			one step every fire spread tick. It keeps its heat on fuel (wood and
+			standing houses) and loses one heat a step on bare ground, and
+			never crosses river, hills, mountains, earth or water.
+			The field is a shortest path tree grown from the burning tiles.
+			After a tick only the tiles the tick updated are checked, and only
+			the parts of the tree that hang off a tile that changed are grown
+			again, so the cost follows the fire front and not the Map.
+			The main functions of Fire_Arrival.cpp are:
+			-Rebuild
+				Grows the whole field from the burning tiles
+			-Update
+				Repairs the field after a tick from the tiles it updated
+			-Get_Ticks
+				Ticks until fire is expected on a tile
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+
+struct Tile_Grid;
+
+// What the fire will do over the next ticks, filled in by the Map
+struct Fire_Conditions
+{
+	u8 wind_direction{};
+	s32 wind_ticks{};				// Ticks the wind still blows for
+	s32 spread_ticks{ 1 };			// Ticks between fire spreading
+	s32 ticks_to_spread{};			// Fire spreads on the tick after this many ticks
+	bool houses_standing{};			// Houses burn while they have durability
+};
+
+class Fire_Arrival
+{
+	s32 x_size{};
+	s32 y_size{};
+	s32 layers{ 1 };				// Heat lost on bare ground, one node per heat left
+	s32 now{};						// Ticks since the last Rebuild
+	s32 phase{};					// Fire spreads on ticks now where now % spread_ticks == phase
+	s32 spread_ticks{ 1 };
+	u8 wind_direction{};
+	s32 wind_end{};					// First tick without wind
+	bool houses_standing{};
+	bool built{ false };
+
+	std::vector<s32> arrival{};		// Tick fire reaches a node, tile * layers + layer
+	std::vector<s32> parent{};		// Node the fire reaches a node from
+	std::vector<u8> kind{};			// Tile class and burning bit, see Tile_Kind
+	std::vector<std::pair<s32, s32>> heap{};	// (arrival, node), min heap
+	std::vector<s32> invalid{};		// Nodes cleared this update, grown again from their neighbours
+	std::vector<s32> stack{};
+
+	u8 Tile_Kind(Tile_Grid const& grid, s32 tile) const;
+
+	s32 Next_Spread(s32 tick) const;
+
+	s32 Spread_Arrival(s32 from_arrival, s32 x_offset, s32 y_offset) const;
+
+	void Set_Root(s32 tile, s32 layer, s32 tick);
+
+	void Invalidate(s32 first_node);
+
+	void Invalidate_Tile(s32 tile);
+
+	void Regrow(s32 node);
+
+	void Check_Tile(Tile_Grid const& grid, s32 tile);
+
+	void Grow();
+
+public:
+	static constexpr s32 UNREACHABLE{ 0x7FFFFFFF };
+
+	void Resize(s32 x_value, s32 y_value);
+
+	void Clear();
+
+	void Rebuild(Tile_Grid const& grid, Fire_Conditions const& conditions);
+
+	void Update(Tile_Grid const& grid, std::vector<s32> const* updated_tiles, Fire_Conditions const& conditions);
+
+	bool Is_Built() const;
+
+	s32 Get_Ticks(s32 x_value, s32 y_value) const;
+};
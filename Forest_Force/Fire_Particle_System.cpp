@@ -29,9 +29,12 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Fire_Particle_System.hpp"
 #include "Map.hpp"
 #include "Player.hpp"
+#include "Random.hpp"
+#include <algorithm>					// std::lower_bound
 
 static std::vector<Particle> fire_particles;
 static size_t fire_alive;
+static std::vector<f32> fire_rolls;			// Random values of a spawn burst
 
 /**************************************************************************/
 /*!
@@ -50,24 +53,35 @@ void Fire_Particles_Load() {
 */
 /**************************************************************************/
 void Fire_Particles_Spawn(s32 tile_x, s32 tile_y, size_t num_particles) {
-	for (size_t i = 0; i < num_particles; ++i) {
-		if (fire_alive < FIRE_PARTICLE_MAX_AMOUNT) {
-			Particle data = {};
-			data.x = static_cast<f32>(tile_x) + Random_Float(-FIRE_PARTICLE_OFFSET, FIRE_PARTICLE_OFFSET);
-			data.y = static_cast<f32>(tile_y) + Random_Float(-FIRE_PARTICLE_OFFSET, FIRE_PARTICLE_OFFSET);
-			data.vel_x = 0;
-			data.vel_y = Random_Float(FIRE_PARTICLE_VELOCITY_MIN, FIRE_PARTICLE_VELOCITY_MAX);
-			data.lifetime = Random_Float(static_cast<float>(FIRE_PARTICLE_LIFETIME_MIN), static_cast<float>(FIRE_PARTICLE_LIFETIME_MAX));
-			data.scale_x = FIRE_PARTICLE_SCALE;
-			data.scale_y = FIRE_PARTICLE_SCALE;
-			data.rotation = 0;
-			data.color_r = 0.1f;
-			data.color_g = 0.1f;
-			data.color_b = 0.1f;
-
-			++fire_alive;
-			fire_particles[fire_alive - 1] = data;
-		}
+	size_t spawn = std::min(num_particles, FIRE_PARTICLE_MAX_AMOUNT - fire_alive);
+
+	// Roll the whole burst at once, one value range after another
+	fire_rolls.resize(spawn * 4);
+	f32* offset_x = fire_rolls.data();
+	f32* offset_y = offset_x + spawn;
+	f32* vel_y = offset_y + spawn;
+	f32* lifetime = vel_y + spawn;
+	Random& random = Thread_Random();
+	random.Fill_Range(offset_x, spawn, -FIRE_PARTICLE_OFFSET, FIRE_PARTICLE_OFFSET);
+	random.Fill_Range(offset_y, spawn, -FIRE_PARTICLE_OFFSET, FIRE_PARTICLE_OFFSET);
+	random.Fill_Range(vel_y, spawn, FIRE_PARTICLE_VELOCITY_MIN, FIRE_PARTICLE_VELOCITY_MAX);
+	random.Fill_Range(lifetime, spawn, static_cast<f32>(FIRE_PARTICLE_LIFETIME_MIN), static_cast<f32>(FIRE_PARTICLE_LIFETIME_MAX));
+
+	for (size_t i = 0; i < spawn; ++i) {
+		Particle data = {};
+		data.x = static_cast<f32>(tile_x) + offset_x[i];
+		data.y = static_cast<f32>(tile_y) + offset_y[i];
+		data.vel_x = 0;
+		data.vel_y = vel_y[i];
+		data.lifetime = lifetime[i];
+		data.scale_x = FIRE_PARTICLE_SCALE;
+		data.scale_y = FIRE_PARTICLE_SCALE;
+		data.rotation = 0;
+		data.color_r = 0.1f;
+		data.color_g = 0.1f;
+		data.color_b = 0.1f;
+
+		fire_particles[fire_alive++] = data;
 	}
 }
 
@@ -88,21 +102,29 @@ void Fire_Particles_Update() {
 	{
 		animation_time_counter = FIRE_PARTICLE_SPAWN_TIME;
 
-		std::pair<s8, s8> temp = {};
+		std::pair<s32, s32> temp = {};
 		player.Get_Player_Tiles_Coordinates(temp.first, temp.second);
 		int draw_limit_y = static_cast<int>(AEGfxGetWindowHeight() / GRID_SIZE);
 		int draw_limit_x = static_cast<int>(AEGfxGetWindowWidth() / GRID_SIZE);
-		//Draw Tile Type first
-		for (int j = (TILE_Y - 1); j >= 0; j--)
+		int first_y = std::max(temp.second - draw_limit_y, 0);
+		int last_y = std::min(temp.second + draw_limit_y, TILE_Y - 1);
+		int first_x = std::max(temp.first - draw_limit_x, 0);
+		int last_x = std::min(temp.first + draw_limit_x, TILE_X - 1);
+		//Only the burning tiles in the rows on screen are visited, in row major order
+		std::vector<s32> const& burning = level_map.Get_Burning_Tiles();
+		Tile_Grid display = level_map.Get_Display_Grid();
+		auto first = std::lower_bound(burning.begin(), burning.end(), first_y * TILE_X);
+		auto last = std::lower_bound(first, burning.end(), (last_y + 1) * TILE_X);
+		for (auto tile = first; tile != last; ++tile)
 		{
-			if (j < (temp.second - draw_limit_y) || j >(temp.second + draw_limit_y)) continue;
-			for (int i = 0; i < TILE_X; i++)
-			{
-				if (i < (temp.first - draw_limit_x) || i >(temp.first + draw_limit_x)) continue;
-
-				if((level_map.Get_Display_Grid())[j][i].fire > 0)
-				Fire_Particles_Spawn(i, j, (level_map.Get_Display_Grid())[j][i].fire);
-			}
+			int i = *tile % TILE_X;
+			int j = *tile / TILE_X;
+			if (i < first_x || i > last_x)
+				continue;
+
+			s8 fire = display[j][i].Get_Fire();
+			if (fire > 0)
+				Fire_Particles_Spawn(i, j, static_cast<size_t>(fire));
 		}
 	}
 
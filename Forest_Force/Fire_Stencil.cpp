@@ -0,0 +1,472 @@
+/******************************************************************************/
+/*!
+\file		Fire_Stencil.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the row kernels that collate the fire and water
+			around each tile for Map::Fire_Behaviour.
+			The main functions of Fire_Stencil.cpp are:
+			-Get_Fire_Stencil_Kernel
+				Returns the fastest row kernel this CPU supports for a wind
+				direction (AVX2, SSE2 or scalar)
+			-Get_Fire_Stencil_Mask / Get_Water_Stencil_Mask
+				The 3x3 neighbours fire and water are collected from
+			-Unpack_Fire_Row
+				Unpacks the fire and river of a run of tiles into byte lanes
+			-Fire_Stencil::Resize
+				Sizes the scratch rows for a map width
+			-Fire_Stencil::Begin
+				Picks the grid and row kernel for a tick
+			-Fire_Stencil::Sum_Row
+				Unpacks the rows around a run of a map row and runs the
+				row kernel on it
+
+			Every kernel adds the same s8 values in the same lanes, so they
+			give the same totals as the scalar kernel bit for bit.
+			Define FIRE_STENCIL_NO_SIMD or FIRE_STENCIL_NO_AVX2 to build
+			without the vector kernels.
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Fire_Stencil.hpp"
+#include "Map.hpp"
+
+#if !defined(FIRE_STENCIL_NO_SIMD) && (defined(_M_X64) || defined(__x86_64__))
+#define FIRE_STENCIL_SSE2
+#if !defined(FIRE_STENCIL_NO_AVX2)
+#define FIRE_STENCIL_AVX2
+#endif
+#endif
+
+#if defined(FIRE_STENCIL_SSE2)
+#include <immintrin.h>					// SSE2 and AVX2 intrinsics
+#if defined(_MSC_VER)
+#include <intrin.h>						// __cpuid, _xgetbv
+#endif
+#endif
+
+// MSVC compiles AVX2 intrinsics anywhere, GCC and Clang need them enabled per function
+#if defined(FIRE_STENCIL_AVX2) && !defined(_MSC_VER)
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define AVX2_FUNCTION
+#endif
+
+//Annonymous Namespace
+namespace
+{
+	// Kernels work on this many tiles at a time, rows are padded to it
+	const s32 ROW_BLOCK{ 32 };
+	// Tiles unpacked at a time, the tile grid rows are padded to whole cache lines of this many tiles
+	const s32 UNPACK_BLOCK{ 16 };
+
+	/**************************************************************************/
+	/*!
+		 Bit of a 3x3 stencil mask for the neighbour at offset (i, j),
+		 where both offsets are in [-1, 1]
+	*/
+	/**************************************************************************/
+	constexpr u16 Stencil_Bit(int i, int j)
+	{
+		return static_cast<u16>(1u << ((j + 1) * 3 + (i + 1)));
+	}
+
+	// Center tile and its four edge neighbours
+	constexpr u16 PLUS_STENCIL{ static_cast<u16>(Stencil_Bit(0, -1) | Stencil_Bit(-1, 0) | Stencil_Bit(0, 0) | Stencil_Bit(1, 0) | Stencil_Bit(0, 1)) };
+
+	/**************************************************************************/
+	/*!
+		 Returns the tiles fire is collected from for a wind direction.
+		 Wind takes the row/column it blows from plus the center tile,
+		 no wind takes the + shape
+	*/
+	/**************************************************************************/
+	constexpr u16 Fire_Stencil_Mask(u8 wind)
+	{
+		u16 mask{ Stencil_Bit(0, 0) };
+		for (int k{ -1 }; k < 2; ++k)
+		{
+			switch (wind)
+			{
+			case(Map::UP):
+				mask |= Stencil_Bit(k, -1);
+				break;
+			case(Map::DOWN):
+				mask |= Stencil_Bit(k, 1);
+				break;
+			case(Map::LEFT):
+				mask |= Stencil_Bit(1, k);
+				break;
+			case(Map::RIGHT):
+				mask |= Stencil_Bit(-1, k);
+				break;
+			default:
+				mask = PLUS_STENCIL;
+				break;
+			}
+		}
+		return mask;
+	}
+
+	/**************************************************************************/
+	/*!
+		 Scalar row kernel, one tile at a time
+	*/
+	/**************************************************************************/
+	template <u8 WIND_DIRECTION>
+	void Scalar_Kernel(Fire_Stencil& stencil)
+	{
+		constexpr u16 FIRE_MASK{ Fire_Stencil_Mask(WIND_DIRECTION) };
+		for (s32 x{ stencil.x_begin }; x < stencil.x_end; ++x)
+		{
+			s8 fire_sum{}, fire_count{}, water_sum{}, water_count{};
+			u8 river{};
+			for (int j{ -1 }; j < 2; ++j)
+			{
+				for (int i{ -1 }; i < 2; ++i)
+				{
+					s8 fire{ stencil.fire_plane[j + 1][x + i + 1] };
+					river |= stencil.river_plane[j + 1][x + i + 1];
+					if (fire < 0 && (PLUS_STENCIL & Stencil_Bit(i, j)))
+					{
+						water_sum = static_cast<s8>(water_sum + fire);
+						++water_count;
+					}
+					else if (fire > 0 && (FIRE_MASK & Stencil_Bit(i, j)))
+					{
+						fire_sum = static_cast<s8>(fire_sum + fire);
+						++fire_count;
+					}
+				}
+			}
+			stencil.fire_sum[x] = fire_sum;
+			stencil.fire_count[x] = fire_count;
+			stencil.water_sum[x] = water_sum;
+			stencil.water_count[x] = water_count;
+			stencil.near_river[x] = river;
+		}
+	}
+
+	/**************************************************************************/
+	/*!
+		 Scalar unpack of count tiles into a fire plane and a river plane
+	*/
+	/**************************************************************************/
+	void Scalar_Unpack(Tiles const* tiles, s32 count, s8* fire, u8* river)
+	{
+		for (s32 x{}; x < count; ++x)
+		{
+			fire[x] = tiles[x].Get_Fire();
+			river[x] = tiles[x].Get_Tile_Type() == Map::RIVER ? 0xFF : 0;
+		}
+	}
+
+#if defined(FIRE_STENCIL_SSE2)
+	/**************************************************************************/
+	/*!
+		 SSE2 row kernel, 16 tiles at a time. A lane compare gives 0 or -1,
+		 so subtracting it counts and and-ing with it masks the sum
+	*/
+	/**************************************************************************/
+	template <u8 WIND_DIRECTION>
+	void Sse2_Kernel(Fire_Stencil& stencil)
+	{
+		constexpr u16 FIRE_MASK{ Fire_Stencil_Mask(WIND_DIRECTION) };
+		__m128i const zero{ _mm_setzero_si128() };
+		for (s32 x{ stencil.x_begin }; x < stencil.x_end; x += 16)
+		{
+			__m128i fire_sum{ zero }, fire_count{ zero }, water_sum{ zero }, water_count{ zero }, river{ zero };
+			for (int j{ -1 }; j < 2; ++j)
+			{
+				s8 const* fire_row{ stencil.fire_plane[j + 1].data() + x + 1 };
+				u8 const* river_row{ stencil.river_plane[j + 1].data() + x + 1 };
+				for (int i{ -1 }; i < 2; ++i)
+				{
+					__m128i fire{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(fire_row + i)) };
+					river = _mm_or_si128(river, _mm_loadu_si128(reinterpret_cast<__m128i const*>(river_row + i)));
+					if (PLUS_STENCIL & Stencil_Bit(i, j))
+					{
+						__m128i wet{ _mm_cmpgt_epi8(zero, fire) };
+						water_sum = _mm_add_epi8(water_sum, _mm_and_si128(fire, wet));
+						water_count = _mm_sub_epi8(water_count, wet);
+					}
+					if (FIRE_MASK & Stencil_Bit(i, j))
+					{
+						__m128i burning{ _mm_cmpgt_epi8(fire, zero) };
+						fire_sum = _mm_add_epi8(fire_sum, _mm_and_si128(fire, burning));
+						fire_count = _mm_sub_epi8(fire_count, burning);
+					}
+				}
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(stencil.fire_sum.data() + x), fire_sum);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(stencil.fire_count.data() + x), fire_count);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(stencil.water_sum.data() + x), water_sum);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(stencil.water_count.data() + x), water_count);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(stencil.near_river.data() + x), river);
+		}
+	}
+
+	/**************************************************************************/
+	/*!
+		 SSE2 unpack of 16 tiles at a time. Fire is sign extended by
+		 shifting it to the top of each 32 bit tile and back, then the
+		 lanes are narrowed to bytes with saturating packs
+	*/
+	/**************************************************************************/
+	void Sse2_Unpack(Tiles const* tiles, s32 count, s8* fire, u8* river)
+	{
+		__m128i const zero{ _mm_setzero_si128() };
+		__m128i const type_mask{ _mm_set1_epi32(static_cast<int>(Tiles::TYPE_MASK << Tiles::TYPE_SHIFT)) };
+		const int fire_top{ 32 - Tiles::FIRE_BITS - Tiles::FIRE_SHIFT };
+		const int fire_bottom{ 32 - Tiles::FIRE_BITS };
+		for (s32 x{}; x < count; x += UNPACK_BLOCK)
+		{
+			__m128i fire_lanes[4]{}, river_lanes[4]{};
+			for (int k{}; k < 4; ++k)
+			{
+				__m128i packed{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(tiles + x + k * 4)) };
+				fire_lanes[k] = _mm_srai_epi32(_mm_slli_epi32(packed, fire_top), fire_bottom);
+				river_lanes[k] = _mm_cmpeq_epi32(_mm_and_si128(packed, type_mask), zero);
+			}
+			__m128i fire_bytes{ _mm_packs_epi16(_mm_packs_epi32(fire_lanes[0], fire_lanes[1]), _mm_packs_epi32(fire_lanes[2], fire_lanes[3])) };
+			__m128i river_bytes{ _mm_packs_epi16(_mm_packs_epi32(river_lanes[0], river_lanes[1]), _mm_packs_epi32(river_lanes[2], river_lanes[3])) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(fire + x), fire_bytes);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(river + x), river_bytes);
+		}
+	}
+#endif
+
+#if defined(FIRE_STENCIL_AVX2)
+	/**************************************************************************/
+	/*!
+		 AVX2 row kernel, same as the SSE2 kernel on 32 tiles at a time
+	*/
+	/**************************************************************************/
+	template <u8 WIND_DIRECTION>
+	AVX2_FUNCTION void Avx2_Kernel(Fire_Stencil& stencil)
+	{
+		constexpr u16 FIRE_MASK{ Fire_Stencil_Mask(WIND_DIRECTION) };
+		__m256i const zero{ _mm256_setzero_si256() };
+		for (s32 x{ stencil.x_begin }; x < stencil.x_end; x += 32)
+		{
+			__m256i fire_sum{ zero }, fire_count{ zero }, water_sum{ zero }, water_count{ zero }, river{ zero };
+			for (int j{ -1 }; j < 2; ++j)
+			{
+				s8 const* fire_row{ stencil.fire_plane[j + 1].data() + x + 1 };
+				u8 const* river_row{ stencil.river_plane[j + 1].data() + x + 1 };
+				for (int i{ -1 }; i < 2; ++i)
+				{
+					__m256i fire{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(fire_row + i)) };
+					river = _mm256_or_si256(river, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(river_row + i)));
+					if (PLUS_STENCIL & Stencil_Bit(i, j))
+					{
+						__m256i wet{ _mm256_cmpgt_epi8(zero, fire) };
+						water_sum = _mm256_add_epi8(water_sum, _mm256_and_si256(fire, wet));
+						water_count = _mm256_sub_epi8(water_count, wet);
+					}
+					if (FIRE_MASK & Stencil_Bit(i, j))
+					{
+						__m256i burning{ _mm256_cmpgt_epi8(fire, zero) };
+						fire_sum = _mm256_add_epi8(fire_sum, _mm256_and_si256(fire, burning));
+						fire_count = _mm256_sub_epi8(fire_count, burning);
+					}
+				}
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(stencil.fire_sum.data() + x), fire_sum);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(stencil.fire_count.data() + x), fire_count);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(stencil.water_sum.data() + x), water_sum);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(stencil.water_count.data() + x), water_count);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(stencil.near_river.data() + x), river);
+		}
+	}
+
+	/**************************************************************************/
+	/*!
+		 Checks that both the CPU and the OS support AVX2
+	*/
+	/**************************************************************************/
+	bool Has_Avx2()
+	{
+#if defined(_MSC_VER)
+		int info[4]{};
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		bool os_saves_avx{ (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 };
+		if (!os_saves_avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	using Unpack_Function = void (*)(Tiles const* tiles, s32 count, s8* fire, u8* river);
+
+	// Kernels of one instruction set, indexed by Map::WIND
+	struct Kernel_Set
+	{
+		Fire_Stencil_Kernel kernels[5];
+		Unpack_Function unpack;
+	};
+
+	/**************************************************************************/
+	/*!
+		 Picks the widest instruction set this CPU runs
+	*/
+	/**************************************************************************/
+	Kernel_Set Select_Kernels()
+	{
+#if defined(FIRE_STENCIL_AVX2)
+		if (Has_Avx2())
+		{
+			return { { Avx2_Kernel<Map::NO_WIND>, Avx2_Kernel<Map::UP>, Avx2_Kernel<Map::DOWN>, Avx2_Kernel<Map::LEFT>, Avx2_Kernel<Map::RIGHT> }, Sse2_Unpack };
+		}
+#endif
+#if defined(FIRE_STENCIL_SSE2)
+		return { { Sse2_Kernel<Map::NO_WIND>, Sse2_Kernel<Map::UP>, Sse2_Kernel<Map::DOWN>, Sse2_Kernel<Map::LEFT>, Sse2_Kernel<Map::RIGHT> }, Sse2_Unpack };
+#else
+		return { { Scalar_Kernel<Map::NO_WIND>, Scalar_Kernel<Map::UP>, Scalar_Kernel<Map::DOWN>, Scalar_Kernel<Map::LEFT>, Scalar_Kernel<Map::RIGHT> }, Scalar_Unpack };
+#endif
+	}
+
+	/**************************************************************************/
+	/*!
+		 Returns the kernels picked for this CPU, picked on first use
+	*/
+	/**************************************************************************/
+	Kernel_Set const& Get_Kernels()
+	{
+		static const Kernel_Set kernel_set{ Select_Kernels() };
+		return kernel_set;
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the row kernel of a wind direction for the
+	 widest instruction set this CPU runs
+*/
+/**************************************************************************/
+Fire_Stencil_Kernel Get_Fire_Stencil_Kernel(u8 wind_direction)
+{
+	Kernel_Set const& kernel_set{ Get_Kernels() };
+	return wind_direction <= Map::RIGHT ? kernel_set.kernels[wind_direction] : kernel_set.kernels[Map::NO_WIND];
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the 3x3 neighbours fire is collected from for a
+	 wind direction, bit (j + 1) * 3 + (i + 1) for the offset (i, j)
+*/
+/**************************************************************************/
+u16 Get_Fire_Stencil_Mask(u8 wind_direction)
+{
+	return Fire_Stencil_Mask(wind_direction <= Map::RIGHT ? wind_direction : static_cast<u8>(Map::NO_WIND));
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the 3x3 neighbours water is collected from, in
+	 the bits of Get_Fire_Stencil_Mask
+*/
+/**************************************************************************/
+u16 Get_Water_Stencil_Mask()
+{
+	return PLUS_STENCIL;
+}
+
+/**************************************************************************/
+/*!
+	 This function unpacks the fire and river of count tiles in a row into
+	 byte lanes, with the unpack this CPU runs fastest. Tiles are read and
+	 lanes written in blocks of 16, up to 15 past count
+*/
+/**************************************************************************/
+void Unpack_Fire_Row(Tiles const* tiles, s32 count, s8* fire, u8* river)
+{
+	Get_Kernels().unpack(tiles, count, fire, river);
+}
+
+/**************************************************************************/
+/*!
+	 This function sizes the scratch rows for a map x_value tiles wide.
+	 Rows are padded so the kernels never need a scalar tail
+*/
+/**************************************************************************/
+void Fire_Stencil::Resize(s32 x_value)
+{
+	width = x_value;
+	size_t totals{ static_cast<size_t>((width + ROW_BLOCK - 1) / ROW_BLOCK * ROW_BLOCK + ROW_BLOCK) };
+	size_t planes{ totals + ROW_BLOCK };
+	for (int k{}; k < 3; ++k)
+	{
+		fire_plane[k].assign(planes, 0);
+		river_plane[k].assign(planes, 0);
+	}
+	fire_sum.assign(totals, 0);
+	fire_count.assign(totals, 0);
+	water_sum.assign(totals, 0);
+	water_count.assign(totals, 0);
+	near_river.assign(totals, 0);
+	rows_loaded = false;
+}
+
+/**************************************************************************/
+/*!
+	 This function sets the grid read and the row kernel used for a tick
+	 and forgets the rows unpacked from the last tick
+*/
+/**************************************************************************/
+void Fire_Stencil::Begin(Tile_Grid const& refer, u8 wind_direction)
+{
+	grid = &refer;
+	kernel = Get_Fire_Stencil_Kernel(wind_direction);
+	rows_loaded = false;
+}
+
+/**************************************************************************/
+/*!
+	 This function unpacks the rows around columns x_first to x_last of
+	 row y_value and runs the kernel on them. Walking down whole rows in
+	 order unpacks only one new row each
+*/
+/**************************************************************************/
+void Fire_Stencil::Sum_Row(s32 y_value, s32 x_first, s32 x_last)
+{
+	Unpack_Function unpack{ Get_Kernels().unpack };
+	// Start on a cache line of the grid row, which starts at the halo column
+	s32 first{ x_first / UNPACK_BLOCK * UNPACK_BLOCK };
+	// Halo column to halo column, rounded up to what a grid row is padded to
+	s32 count{ (x_last + 2 - first + UNPACK_BLOCK - 1) / UNPACK_BLOCK * UNPACK_BLOCK };
+
+	if (rows_loaded && row + 1 == y_value && first == x_begin && x_last == x_end)
+	{
+		std::swap(fire_plane[0], fire_plane[1]);
+		std::swap(fire_plane[1], fire_plane[2]);
+		std::swap(river_plane[0], river_plane[1]);
+		std::swap(river_plane[1], river_plane[2]);
+		unpack((*grid)[y_value + 1] - 1 + first, count, fire_plane[2].data() + first, river_plane[2].data() + first);
+	}
+	else
+	{
+		for (int k{}; k < 3; ++k)
+		{
+			unpack((*grid)[y_value - 1 + k] - 1 + first, count, fire_plane[k].data() + first, river_plane[k].data() + first);
+		}
+	}
+	row = y_value;
+	x_begin = first;
+	x_end = x_last;
+	rows_loaded = true;
+
+	kernel(*this);
+}
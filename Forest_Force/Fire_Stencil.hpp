@@ -0,0 +1,97 @@
+/******************************************************************************/
+/*!
+\file		Fire_Stencil.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the row kernels that collate the fire and water
+			around each tile for Map::Fire_Behaviour.
+			The main functions of Fire_Stencil.cpp are:
+			-Get_Fire_Stencil_Kernel
+				Returns the fastest row kernel this CPU supports for a wind
+				direction (AVX2, SSE2 or scalar)
+			-Get_Fire_Stencil_Mask / Get_Water_Stencil_Mask
+				The 3x3 neighbours fire and water are collected from
+			-Unpack_Fire_Row
+				Unpacks the fire and river of a run of tiles into byte lanes
+			-Fire_Stencil::Resize
+				Sizes the scratch rows for a map width
+			-Fire_Stencil::Begin
+				Picks the grid and row kernel for a tick
+			-Fire_Stencil::Sum_Row
+				Unpacks the rows around a run of a map row and runs the
+				row kernel on it
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+
+struct Tiles;
+struct Tile_Grid;
+struct Fire_Stencil;
+
+// Fire/water totals of the stencil around one tile, what Map::Fire_Behaviour reads
+struct Fire_Totals
+{
+	s8 fire_sum{};
+	s8 fire_count{};
+	s8 water_sum{};
+	s8 water_count{};
+	bool near_river{};
+};
+
+// Row kernel, fills the stencil totals of every tile of the row in stencil
+using Fire_Stencil_Kernel = void (*)(Fire_Stencil& stencil);
+
+// Fire/water totals of the 3x3 stencil for a run of tiles in one map row.
+// The rows above, at and below are unpacked into s8 fire planes and river
+// planes (0xFF where the tile is river) so the kernels can work on byte lanes.
+// Element 0 of a plane is column -1 (the halo), element x of a total is column x.
+// Only the totals from x_begin to x_end of row are valid.
+struct Fire_Stencil
+{
+	std::vector<s8> fire_plane[3];
+	std::vector<u8> river_plane[3];
+
+	std::vector<s8> fire_sum;		// Fire collected from the wind shaped stencil
+	std::vector<s8> fire_count;		// Burning tiles in the wind shaped stencil
+	std::vector<s8> water_sum;		// Water collected from the + shaped stencil
+	std::vector<s8> water_count;	// Wet tiles in the + shaped stencil
+	std::vector<u8> near_river;		// Non zero if any tile in the 3x3 is river
+
+	Tile_Grid const* grid{ nullptr };
+	Fire_Stencil_Kernel kernel{ nullptr };
+	s32 width{};
+	s32 row{};
+	s32 x_begin{};
+	s32 x_end{};
+	bool rows_loaded{};
+
+	void Resize(s32 x_value);
+
+	void Begin(Tile_Grid const& refer, u8 wind_direction);
+
+	void Sum_Row(s32 y_value, s32 x_first, s32 x_last);
+
+	bool Covers(s32 x_value, s32 y_value) const
+	{
+		return rows_loaded && row == y_value && x_value >= x_begin && x_value < x_end;
+	}
+
+	Fire_Totals Get_Totals(s32 x_value) const
+	{
+		return Fire_Totals{ fire_sum[x_value], fire_count[x_value], water_sum[x_value], water_count[x_value], near_river[x_value] != 0 };
+	}
+};
+
+Fire_Stencil_Kernel Get_Fire_Stencil_Kernel(u8 wind_direction);
+
+u16 Get_Fire_Stencil_Mask(u8 wind_direction);
+
+u16 Get_Water_Stencil_Mask();
+
+void Unpack_Fire_Row(Tiles const* tiles, s32 count, s8* fire, u8* river);
@@ -16,8 +16,8 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 
 #pragma once
 
-extern s8 TILE_X; 
-extern s8 TILE_Y;	
+extern s32 TILE_X; 
+extern s32 TILE_Y;	
 
 extern float GRID_SIZE;
 extern const u8 LAST_LEVEL;
@@ -51,6 +51,6 @@ enum LEVEL_STATES : u8 {
 	LS_VICTORY
 };
 
-enum STATUS : u8 {
-	INVALID_TILE = 200
+enum STATUS : s32 {
+	INVALID_TILE = -1
 };
\ No newline at end of file
@@ -16,6 +16,10 @@
 				Draws spellcast UI with lerp animations
 			-Draw_Map(Chua Jim Hans)
 				Draws 2D map of the current update frame
+			-Draw_Risk_Map(agent)
+				Draws the risk of fire over the map
+			-Draw_Fire_Warning(agent)
+				Warns the player when fire is about to reach them
 			-Draw_Player_Spell_Range(Lim Zhen Eu Damon)
 				Draws spell range fixed to player position
 			-Draw_Paused_Objectives_UI(Lim Zhen Eu Damon)
@@ -49,13 +53,19 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Camera.hpp"
 #include "Graphics_Utils.hpp"
 #include "Map.hpp"
+#include "World.hpp"
 #include "Objectives.hpp"
 #include "Level.hpp"
 #include "Level_Editor.hpp"
+#include <cmath>						// std::ceil
 
 static const f64 MAP_ANIMATION_TIME{ 1.0f };
 static const f32 MAP_COLOR_FIRE[4]{ 1.0f,0.f,0.f,0.2f }; // For the R, G, B, 
 static const f32 MAP_COLOR_WATER[4]{ 0.0f, 0.0f, 0.7f, 0.5f }; // For the R, G, B, 
+static const f32 MAP_COLOR_RISK[4]{ 1.0f, 0.5f, 0.0f, 0.6f }; // For the R, G, B, A at full risk
+static const f32 MAP_RISK_MIN{ 0.02f };		// Risk below this is not drawn
+static const f32 FIRE_WARNING_Y{ 0.75f };
+static const f32 FIRE_WARNING_COLOR[4]{ 1.0f, 0.4f, 0.0f, 1.0f }; // For the R, G, B, A
 static const f32 COLOR_TEXTURE[4]{ 1.0f, 1.0f, 1.0f, 1.0f }; // For the R, G, B, A
 
 static const f32 OBJ_UI_X_OFFSET = -0.95f;
@@ -322,24 +332,26 @@ void Draw_Map(Tile_Asset& asset)
 
 	int draw_limit_y = static_cast<int>(AEGfxGetWindowHeight() / GRID_SIZE);
 	int draw_limit_x = static_cast<int>(AEGfxGetWindowWidth() / GRID_SIZE);
-	std::pair<s8, s8> temp = {};
+	std::pair<s32, s32> temp = {};
 	player.Get_Player_Tiles_Coordinates(temp.first, temp.second);
+	// Only visit the tiles around the player, large maps have far more tiles than fit on screen
+	int first_y = std::max(temp.second - draw_limit_y, 0);
+	int last_y = std::min(temp.second + draw_limit_y, TILE_Y - 1);
+	int first_x = std::max(temp.first - draw_limit_x, 0);
+	int last_x = std::min(temp.first + draw_limit_x, TILE_X - 1);
 	//Draw Tile Type first
-	for (int j = (TILE_Y - 1); j >= 0; j--)
+	for (int j = last_y; j >= first_y; j--)
 	{
 		//Draw Terrain Type and Player together {
 
-		if (j < (temp.second - draw_limit_y) || j >(temp.second + draw_limit_y))continue;
-
-		for (int i = 0; i < TILE_X; i++) {
-			if (i < (temp.first - draw_limit_x) || i >(temp.first + draw_limit_x))continue;
+		for (int i = first_x; i <= last_x; i++) {
 			Tiles const& grid = (level_map.Get_Display_Grid())[j][i];
 			AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
 			AEGfxSetBlendMode(AE_GFX_BM_BLEND); // Allow Transparency
 			AEGfxSetTransparency(1.0f);
 			AEGfxSetColorToMultiply(COLOR_TEXTURE[0], COLOR_TEXTURE[1], COLOR_TEXTURE[2], COLOR_TEXTURE[3]);
 
-			switch (grid.tile_type)
+			switch (grid.Get_Tile_Type())
 			{
 			case(Map::GRASS):
 				AEGfxTextureSet(asset.grass_tile, 0, 0);
@@ -370,7 +382,7 @@ void Draw_Map(Tile_Asset& asset)
 			AEGfxMeshDraw(p_mesh, AE_GFX_MDM_TRIANGLES);
 
 			//Draw Fire Indicator 
-			if (grid.is_near_fire)
+			if (grid.Is_Near_Fire())
 			{
 				AEGfxSetRenderMode(AE_GFX_RM_COLOR);
 				AEGfxTextureSet(NULL, 0, 0);
@@ -387,12 +399,10 @@ void Draw_Map(Tile_Asset& asset)
 			}
 		}
 	}
-	for (int j = (TILE_Y - 1); j >= 0; j--)
+	for (int j = last_y; j >= first_y; j--)
 	{
-		if (j < (temp.second - draw_limit_y) || j >(temp.second + draw_limit_y))continue;
-		for (int i = 0; i < TILE_X; i++)
+		for (int i = first_x; i <= last_x; i++)
 		{
-			if (i < (temp.first - draw_limit_x) || i >(temp.first + draw_limit_x))continue;
 			Tiles const& grid = (level_map.Get_Display_Grid())[j][i];
 			AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
 			AEGfxSetBlendMode(AE_GFX_BM_BLEND); // Allow Transparency
@@ -400,7 +410,7 @@ void Draw_Map(Tile_Asset& asset)
 			AEGfxSetColorToMultiply(COLOR_TEXTURE[0], COLOR_TEXTURE[1], COLOR_TEXTURE[2], COLOR_TEXTURE[3]);
 
 			float height_ratio{};
-			switch (grid.terrain_type)
+			switch (grid.Get_Terrain_Type())
 			{
 			case(Map::BUSH):
 
@@ -415,7 +425,7 @@ void Draw_Map(Tile_Asset& asset)
 				AEGfxTextureSet(asset.tree_obj, 0, 0);
 				break;
 			case(Map::MOUNTAIN):
-				height_ratio = (static_cast<float>(level_map.max_earth_durability - grid.earth_durability) / 10.f);
+				height_ratio = (static_cast<float>(level_map.max_earth_durability - grid.Get_Earth_Durability()) / 10.f);
 
 				AEMtx33Scale(&scale, 2.f, 3.f - height_ratio);
 				AEGfxTextureSet(asset.mountain_obj, 0, 0);
@@ -451,7 +461,7 @@ void Draw_Map(Tile_Asset& asset)
 			AEGfxSetTransform(transform.m);
 			AEGfxMeshDraw(p_mesh, AE_GFX_MDM_TRIANGLES);
 
-			fire_value = grid.fire;
+			fire_value = grid.Get_Fire();
 			is_fire = fire_value > 0 ? 1 : 0;
 			fire_value = fire_value >= 0 ? fire_value : -fire_value;
 			//Is fire determines to draw Water or Fire
@@ -495,6 +505,73 @@ void Draw_Map(Tile_Asset& asset)
 
 }
 
+/**************************************************************************/
+/*!
+	 This function draws the risk map over the tiles around the player,
+	 tiles turn from orange to red and more opaque as their risk of
+	 burning rises
+*/
+/**************************************************************************/
+void Draw_Risk_Map(Risk_Map& risk)
+{
+	AEMtx33 map_scale{};
+	AEMtx33 map_transform{};
+	AEMtx33Trans(&map_translate, static_cast<f32>((GRID_SIZE) / 2.0f), static_cast<f32>((GRID_SIZE) / 2.0f));
+	AEMtx33Scale(&map_scale, GRID_SIZE, GRID_SIZE);
+	AEMtx33Concat(&map_transform, &map_translate, &map_scale);
+
+	int draw_limit_y = static_cast<int>(AEGfxGetWindowHeight() / GRID_SIZE);
+	int draw_limit_x = static_cast<int>(AEGfxGetWindowWidth() / GRID_SIZE);
+	std::pair<s32, s32> temp = {};
+	player.Get_Player_Tiles_Coordinates(temp.first, temp.second);
+	int first_y = std::max(temp.second - draw_limit_y, 0);
+	int last_y = std::min(temp.second + draw_limit_y, TILE_Y - 1);
+	int first_x = std::max(temp.first - draw_limit_x, 0);
+	int last_x = std::min(temp.first + draw_limit_x, TILE_X - 1);
+
+	AEGfxSetRenderMode(AE_GFX_RM_COLOR);
+	AEGfxSetBlendMode(AE_GFX_BM_BLEND); // Allow Transparency
+	AEGfxSetTransparency(1.0f);
+	AEGfxTextureSet(NULL, 0, 0);
+	for (int j = last_y; j >= first_y; j--)
+	{
+		for (int i = first_x; i <= last_x; i++)
+		{
+			f32 tile_risk{ risk.Get_Risk(i, j) };
+			if (tile_risk < MAP_RISK_MIN)
+				continue;
+
+			AEGfxSetColorToMultiply(MAP_COLOR_RISK[0], MAP_COLOR_RISK[1] * (1.0f - tile_risk), MAP_COLOR_RISK[2], MAP_COLOR_RISK[3] * tile_risk);
+			AEMtx33Trans(&translate, static_cast<f32>(i * (GRID_SIZE)), static_cast<f32>(j * (GRID_SIZE))); // Sets Position
+			AEMtx33Concat(&transform, &translate, &map_transform);
+			AEGfxSetTransform(transform.m);
+			AEGfxMeshDraw(p_mesh, AE_GFX_MDM_TRIANGLES);
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function warns the player when the fire arrival field of the Map
+	 expects fire on their tile within RISK_TIME, the same time ahead the
+	 risk map looks
+*/
+/**************************************************************************/
+void Draw_Fire_Warning(Map& map, Player& player_param)
+{
+	s32 x_value{}, y_value{};
+	player_param.Get_Player_Tiles_Coordinates(x_value, y_value);
+	s32 ticks{ map.Get_Fire_Arrival(x_value, y_value) };
+	if (ticks <= 0 || ticks * BEHAVIOUR_TIME > RISK_TIME)
+		return;
+
+	std::string str = "Fire reaches you in " + std::to_string(static_cast<s32>(std::ceil(ticks * BEHAVIOUR_TIME))) + "s!";
+	f32 w{}, h{};
+	AEGfxGetPrintSize(p_objectives_font, str.c_str(), 1.f, &w, &h);
+	AEGfxPrint(p_objectives_font, str.c_str(), -w / 2, FIRE_WARNING_Y, 1,
+		FIRE_WARNING_COLOR[0], FIRE_WARNING_COLOR[1], FIRE_WARNING_COLOR[2], FIRE_WARNING_COLOR[3]);
+}
+
 /**************************************************************************/
 /*!
 	 This function draws the range for the spell as highlighted squares.
@@ -566,10 +643,10 @@ void Draw_Player_Spell_Range(Player& player_param) {
 	player_param.Get_Player_World_Coordinates(player_world.first, player_world.second);
 
 	// Draw spell range
-	for (s8 rel_x{ -spell_range }; rel_x <= spell_range; rel_x++) {
+	for (s32 rel_x{ -spell_range }; rel_x <= spell_range; rel_x++) {
 		bool out_of_bounds_x = (player_param.x + rel_x < 0) || (player_param.x + rel_x >= TILE_X);
 		if (out_of_bounds_x) continue;
-		for (s8 rel_y{ -spell_range }; rel_y <= spell_range; rel_y++) {
+		for (s32 rel_y{ -spell_range }; rel_y <= spell_range; rel_y++) {
 			bool out_of_bounds_y = (player.y + rel_y < 0) || (player.y + rel_y >= TILE_Y);
 			bool not_spell_range = (std::abs(rel_x) + std::abs(rel_y) > spell_range);
 			if (out_of_bounds_y || not_spell_range) continue;
@@ -604,9 +681,9 @@ void Draw_Player_Spell_Range(Player& player_param) {
 			{
 				f32 opacity_modifier = 1.0f;
 
-				s8 mouse_x{}, mouse_y{};
+				s32 mouse_x{}, mouse_y{};
 				Get_Mouse_Tile_Coordinates(mouse_x, mouse_y);
-				std::pair<s8, s8> player_tile{};
+				std::pair<s32, s32> player_tile{};
 				player_param.Get_Player_Tiles_Coordinates(player_tile.first, player_tile.second);
 				bool spell_on_cooldown = (player_cast_cooldown > 0);
 				bool mouse_on_grid = (mouse_x == player_tile.first + rel_x) && (mouse_y == player_tile.second + rel_y);
@@ -646,7 +723,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 
 				// i used for removing the specific case where only 1 square needs to be drawn
 				if (i && player_param.y + i < TILE_Y) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(0, player_param.y + static_cast<s8>(i), grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(0, player_param.y + i, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -656,7 +733,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 				}
 
 				if (player_param.y - i >= 0) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(0, player_param.y - static_cast<s8>(i), grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(0, player_param.y - i, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -679,7 +756,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 
 				// i used for removing the specific case where only 1 square needs to be drawn
 				if (i && player_param.y + i < TILE_Y) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(TILE_X - 1, player_param.y + static_cast<s8>(i), grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(TILE_X - 1, player_param.y + i, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -689,7 +766,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 				}
 
 				if (player_param.y - i >= 0) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(TILE_X - 1, player_param.y - static_cast<s8>(i), grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(TILE_X - 1, player_param.y - i, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -712,7 +789,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 
 				// i used for removing the specific case where only 1 square needs to be drawn
 				if (i && player_param.x + i < TILE_X) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(player_param.x + static_cast<s8>(i), 0, grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(player_param.x + i, 0, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -722,7 +799,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 				}
 
 				if (player_param.x - i >= 0) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(player_param.x - static_cast<s8>(i), 0, grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(player_param.x - i, 0, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -745,7 +822,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 
 				// i used for removing the specific case where only 1 square needs to be drawn
 				if (i && player_param.x + i < TILE_X) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(player_param.x + static_cast<s8>(i), TILE_Y - 1, grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(player_param.x + i, TILE_Y - 1, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -755,7 +832,7 @@ void Draw_Player_Spell_Range(Player& player_param) {
 				}
 
 				if (player_param.x - i >= 0) { // Don't draw squares out of range
-					Get_Tiles_To_World_Coordinates(player_param.x - static_cast<s8>(i), TILE_Y - 1, grid_coordinates.first, grid_coordinates.second);
+					Get_Tiles_To_World_Coordinates(player_param.x - i, TILE_Y - 1, grid_coordinates.first, grid_coordinates.second);
 					AEMtx33Scale(&scale, GRID_SIZE + lerp_animation_scale_x, GRID_SIZE + lerp_animation_scale_y); // Scaling Factors (Size of Squares)
 					AEMtx33Trans(&translate, grid_coordinates.first + lerp_animation_translate_x,
 						grid_coordinates.second + lerp_animation_translate_y); // Sets Position
@@ -929,6 +1006,13 @@ void Draw_Objectives_UI(Objectives& objective, Tile_Asset& asset) {
 			break;
 		}
 	}
+
+	// Game speed is only shown when sped up (TAB)
+	if (game_world.Get_Game_Speed() > 1) {
+		str = "Speed: " + std::to_string(game_world.Get_Game_Speed()) + "x";
+		AEGfxGetPrintSize(p_objectives_font, str.c_str(), 1.f, &w, &h);
+		AEGfxPrint(p_objectives_font, str.c_str(), OBJ_UI_X_OFFSET, OBJ_UI_Y_OFFSET - (h * 3 * OBJ_UI_GAP_MODIFIER), 1, 1, 1, 1, 1);
+	}
 }
 
 /**************************************************************************/
@@ -1114,7 +1198,7 @@ void Draw_Map_Editor(Tiles** editor_grid, Editor_Asset & editor_assets, Game_obj
 			AEGfxSetColorToMultiply(COLOR_TEXTURE[0], COLOR_TEXTURE[1], COLOR_TEXTURE[2], COLOR_TEXTURE[3]);
 			AEMtx33Scale(&scale, GRID_SIZE, GRID_SIZE);
 
-			switch (grid->tile_type)
+			switch (grid->Get_Tile_Type())
 			{
 			case(Map::GRASS):
 				AEGfxTextureSet(editor_assets.grass_tile, 0, 0);
@@ -1146,7 +1230,7 @@ void Draw_Map_Editor(Tiles** editor_grid, Editor_Asset & editor_assets, Game_obj
 			AEGfxSetTransparency(1.0f);
 			AEGfxSetColorToMultiply(COLOR_TEXTURE[0], COLOR_TEXTURE[1], COLOR_TEXTURE[2], COLOR_TEXTURE[3]);
 
-			switch (grid->terrain_type)
+			switch (grid->Get_Terrain_Type())
 			{
 			case(Map::BUSH):
 
@@ -1195,7 +1279,7 @@ void Draw_Map_Editor(Tiles** editor_grid, Editor_Asset & editor_assets, Game_obj
 			AEGfxSetTransform(transform.m);
 			AEGfxMeshDraw(p_mesh, AE_GFX_MDM_TRIANGLES);
 
-			fire_value = grid->fire;
+			fire_value = grid->Get_Fire();
 			is_fire = fire_value > 0 ? 1 : 0;
 			fire_value = fire_value >= 0 ? fire_value : -fire_value;
 			if (is_fire && fire_value)
@@ -1229,7 +1313,7 @@ void Draw_Map_Editor(Tiles** editor_grid, Editor_Asset & editor_assets, Game_obj
 	 function as it is not required in the level editor.
 */
 /**************************************************************************/
-void Draw_Player_Editor( s8 const& Player_x, s8 const& Player_y, Editor_Asset & editor_assets)
+void Draw_Player_Editor( s32 const& Player_x, s32 const& Player_y, Editor_Asset & editor_assets)
 {
 	AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
 	AEGfxSetBlendMode(AE_GFX_BM_BLEND); // Allow Transparency
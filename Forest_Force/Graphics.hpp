@@ -16,6 +16,10 @@
 				Draws spellcast UI with lerp animations
 			-Draw_Map(Chua Jim Hans)
 				Draws 2D map of the current update frame
+			-Draw_Risk_Map(agent)
+				Draws the risk of fire over the map
+			-Draw_Fire_Warning(agent)
+				Warns the player when fire is about to reach them
 			-Draw_Player_Spell_Range(Lim Zhen Eu Damon)
 				Draws spell range fixed to player position
 			-Draw_Paused_Objectives_UI(Lim Zhen Eu Damon)
@@ -50,6 +54,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Map.hpp"
 #include "Objectives.hpp"
 #include "Level_Editor.hpp"
+#include "Risk_Map.hpp"
 
 extern AEGfxVertexList* p_mesh;
 extern s8 p_font, p_smaller_font;
@@ -105,6 +110,8 @@ void Draw_Spell_UI(Player& player);
 void Draw_Background(AEGfxTexture* asset);
 
 void Draw_Map(Tile_Asset& asset);
+void Draw_Risk_Map(Risk_Map& risk);
+void Draw_Fire_Warning(Map& map, Player& player_param);
 void Draw_Player_Spell_Range(Player& player);
 void Draw_Paused_Objectives_UI(Objectives& objectives);
 void Draw_Objectives_UI(Objectives& objectives, Tile_Asset& asset);
@@ -115,7 +122,7 @@ void Draw_Defeat_Screen();
 
 void Draw_Map_Editor_Init();
 void Draw_Map_Editor(Tiles** editor_grid, Editor_Asset& editor_assets, Game_object_Stats game_obj_stats); // Draw map for editor
-void Draw_Player_Editor(s8 const& Player_x, s8 const& Player_y, Editor_Asset& editor_assets); // Draw player for editor
+void Draw_Player_Editor(s32 const& Player_x, s32 const& Player_y, Editor_Asset& editor_assets); // Draw player for editor
 void Draw_Popup_Box(u8& Objective_To_Display, std::vector<buttons>& Popup_Buttons, Editor_Asset& editor_assets, s16 const* TL_TC_Array);
 
 void Draw_How_To_Play();
\ No newline at end of file
@@ -44,19 +44,12 @@ AEGfxTexture* panel{ nullptr };
 	This function updates a world x and y given a tile x and y. 
 */
 /**************************************************************************/
-void Get_Tiles_To_World_Coordinates(const s8 &x, const s8 &y, f32& world_x, f32& world_y) { // TODO: THIS GARBAGE
-	for (int i = 0; i < TILE_X; i++) {
-		if (i != x) continue;											// Ignores all tiles not same x as the x given
-		float rect_left = i * GRID_SIZE;								// Left X world coordinate.
-		world_x = static_cast<f32>(rect_left + GRID_SIZE / 2.0f);		// Center X world coordinate (what we want)
-		for (int j = 0; j < TILE_Y; j++) {
-			if (j != y) continue;										// Ignores all tiles not same y as the y given
-			float rect_bottom = j * GRID_SIZE;							// Bottom Y world coordinate.
-			world_y = static_cast<f32>(rect_bottom + GRID_SIZE / 2.0f); // Center Y world coordinate (what we want)
-			break;
-		}
-		break;
-	}
+void Get_Tiles_To_World_Coordinates(const s32 &x, const s32 &y, f32& world_x, f32& world_y) {
+	// Tiles outside the map leave the world coordinates untouched
+	if (x < 0 || x >= TILE_X) return;
+	world_x = static_cast<f32>(x) * GRID_SIZE + GRID_SIZE / 2.0f;		// Center X world coordinate
+	if (y < 0 || y >= TILE_Y) return;
+	world_y = static_cast<f32>(y) * GRID_SIZE + GRID_SIZE / 2.0f;		// Center Y world coordinate
 }
 
 /**************************************************************************/
@@ -24,7 +24,7 @@ extern const f32 POPUP_BUTTON_FALSE[4];
 extern s8 p_objectives_font;
 extern AEGfxVertexList* p_mesh;
 
-void Get_Tiles_To_World_Coordinates(const s8& x, const s8& y, f32& world_x, f32& world_y);
+void Get_Tiles_To_World_Coordinates(const s32& x, const s32& y, f32& world_x, f32& world_y);
 
 void Get_Normalized_To_World_Coordinates(f32& world_x, f32& world_y, const f32& norm_x, const f32& norm_y, bool scale);
 
@@ -19,7 +19,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 /******************************************************************************/
 #include "pch.hpp"
 #include "Level.hpp"
-#include "Map.hpp"
+#include "World.hpp"
 #include "Graphics.hpp"
 #include "Camera.hpp"
 #include "Graphics_Utils.hpp"
@@ -32,20 +32,26 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Fire_Particle_System.hpp"
 #include "Water_Particle_System.hpp"
 #include "Earth_Particle_System.hpp"
+#include "Replay.hpp"
+#include "Random.hpp"
+#include "Risk_Map.hpp"
 
 static const std::string CONFIRMATION_EXIT_GAME_TEXT = "You are about to exit the game";
+static const std::string REPLAY_FILE_PATH = "Data/User/last_replay.txt";	// Replay of the last attempt at a level
 
 enum GS_STATES : u8;								// Forward Declaration of GS_States
 const u8 LAST_LEVEL{ GS_LEVEL_EDITOR };				// Max Level we have in Forest Have
 
-s8 level_state{};									// Game State in Level
-s8 TILE_X;											// Map X (Map Width)
-s8 TILE_Y;											// Map Y (Map Height)
+s8& level_state{ game_world.state };				// Game State in Level
+s32 TILE_X;											// Map X (Map Width)
+s32 TILE_Y;											// Map Y (Map Height)
 float GRID_SIZE;									// Scale of each Grid (In world coordinates)
 
 static std::string warning_text;
 static bool confirmation_pop_up_triggered = false;
 static bool how_to_play_triggered = false;
+static s32 start_snapshot = -1;						// World at the start of the level, restarts restore it
+static std::string level_file;						// Level being played, for its replay
 
 void Level_Load()
 {
@@ -69,21 +75,35 @@ void Level_Load()
 	for (u8 i{}; i <= LAST_LEVEL - GS_LEVEL1; ++i) { 
 		if (current == GS_LEVEL1 + i) {
 			std::string level =  std::to_string(i+1) + ".txt";
-			Read_File(LEVEL_FILE_PATH + level);
+			level_file = LEVEL_FILE_PATH + level;
+			if (!game_world.Load(level_file)) {
+				next = GS_QUIT;
+				return;
+			}
 			break;
 		}
 	}
+	TILE_X = level_map.Get_X_Size();
+	TILE_Y = level_map.Get_Y_Size();
+	game_world.Set_Rewind_Time(REWIND_TIME);
+	// Keeps the fire arrival field up to date for the fire warning
+	level_map.Track_Fire_Arrival(true);
+	player.Load_Assets();
+	objectives.Load_Assets();
 }
 
 void Level_Initialize()
 {
-	// Start Game in playing mode
-	level_state = LS_PLAYING;
-
-	// Initialize Player, Map, Objectives
-	player.Initialize();
-	level_map.Map_Init();
-	objectives.Initialize();
+	// Start Game in playing mode, Initialize Player, Map, Objectives
+	// Restarts only write back the tiles changed since the level started
+	if (start_snapshot >= 0) {
+		game_world.Restore_Snapshot(start_snapshot);
+	}
+	else {
+		game_world.Initialize();
+		start_snapshot = game_world.Take_Snapshot();
+	}
+	game_replay.Start_Recording(level_file, Get_Random_Seed());
 	Camera_Init();
 
 	// Play Music
@@ -198,11 +218,32 @@ void Level_Update()
 				Toggle_Zoom();
 			}
 
+			if (AEInputCheckTriggered(AEVK_TAB))
+			{
+				game_world.Cycle_Game_Speed();
+			}
+
+			if (AEInputCheckTriggered(AEVK_R))
+			{
+				risk_map.Toggle();
+			}
+
 			Player_Input();
 		}
 
-		// Update the Game while playing
-		Map_Update();
+		// Update the Game while playing, holding backspace steps it back at the same pace instead
+		if (AEInputCheckCurr(AEVK_BACK)) {
+			if (game_world.Rewind_Update(delta_time) > 0) {
+				game_replay.Truncate(game_world.Get_Ticks_Run());
+			}
+		}
+		else {
+			game_world.Update(delta_time);
+		}
+		risk_map.Update(level_map);
+		if (level_state == LS_DEFEAT) {
+			Start_Music(defeat_music);
+		}
 		objectives.Update();
 		Fire_Particles_Update();
 		Fire_Particles_Swap();
@@ -268,6 +309,9 @@ void Level_Draw()
 {
 	Draw_Background(map_asset.background_obj);
 	Draw_Map(map_asset);	// Also Draws the player
+	if (risk_map.Is_Shown()) {
+		Draw_Risk_Map(risk_map);
+	}
 	
 	if (level_state == LS_PLAYING)
 	{
@@ -278,6 +322,7 @@ void Level_Draw()
 		Earth_Particles_Emitter();
 		Draw_Spell_UI(player);
 		Draw_Objectives_UI(objectives, map_asset);
+		Draw_Fire_Warning(level_map, player);
 	}
 	else if (level_state == LS_PAUSED) {
 		Draw_Pause_Screen();
@@ -306,6 +351,9 @@ void Level_Draw()
 
 void Level_Free()
 {
+	// Every attempt at a level can be played back from its replay
+	game_replay.Stop_Recording(game_world);
+	game_replay.Save(REPLAY_FILE_PATH);
 	Camera_Free();
 }
 
@@ -321,7 +369,11 @@ void Level_Unload()
 	map_asset.Tile_Asset_Unload();
 
 	// Unload Player, Map and Objectives
+	game_world.Release_Snapshot(start_snapshot);
+	start_snapshot = -1;
 	player.Unload();
+	level_map.Track_Fire_Arrival(false);
 	level_map.Map_Unload();
+	risk_map.Free();
 	objectives.Unload();
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 
 #pragma once
 
-extern s8 level_state; // Game State in Level
+extern s8& level_state; // Game State in Level
 extern AEGfxVertexList* p_mesh;
 
 void Level_Load();
@@ -21,6 +21,9 @@
 			- Set_Objectives
 				Set objectives, as specified by the player, and determines which
 				objective to display
+			- Start_Level_Solver / Check_Level_Solver / Stop_Level_Solver
+				Plays the saved level on a thread of its own, so the editor
+				keeps drawing while it is worked out how many stars it gives
 
 Copyright (C) 2024 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents without the
@@ -37,12 +40,17 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Fileio.hpp"
 #include "Graphics_Utils.hpp"
 #include "Objectives.hpp"
+#include "Solver.hpp"
+#include <thread>						// Solves the saved level off the frame loop
+#include <atomic>						// Tells the editor the solver finished
 
 static f32 font_width{}, font_height{};
 static const f32 pop_up[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
 static const f32 pop_up_color[4] = { 200.0f / 255.0f, 200.0f / 255.0f, 200.0f / 255.0f, 1.0f };
 static std::string POP_UP_TEXT1;
 static const char* POP_UP_TEXT2 = "Press any key to continue!";
+static const std::string SOLUTION_FILE_PATH = "Data/User/editor_solution.txt";	// Replay winning the saved level with the most stars
+static const char* SOLVING_TEXT = "Please wait while it is played!";
 static const f32 pop_up_text_color[4] = { 50.0f / 255.0f, 50.0f / 255.0f, 50.0f / 255.0f, 1.0f };
 
 static const f32 button_true[4] = { -0.3f, -0.4f, 0.4f, 0.2f };
@@ -51,6 +59,12 @@ static bool confirmation_pop_up_triggered = false;
 static bool any_key_pop_up_triggered = false;
 static std::string warning_text;
 
+static Solver level_solver{};
+static std::thread solver_thread{};
+static std::atomic<bool> solver_done{ false };	// Set by the solver thread once level_solver can be read
+static bool solver_loaded = false;				// Written by the solver thread before solver_done
+static bool solver_running = false;
+
 static std::string panel_button_text;
 static f32 close_open_panel_button[4] = { 0.85f, -0.25f, 0.2f, 0.08f };
 static const f32 close_open_panel_button_colour[4] = { 241.0f / 255.0f, 196.0f / 255.0f, 15.0f / 255.0f, 1.0f };
@@ -64,10 +78,10 @@ f32 mouse_x{}, mouse_y{};
 
 Tiles** Create_Grid{ nullptr };
 
-s8 MAX_SIZE_TILE_X = 100;
-s8 MAX_SIZE_TILE_Y = 100;
-s8 MIN_SIZE_TILE_X = 15;
-s8 MIN_SIZE_TILE_Y = 15;
+s32 MAX_SIZE_TILE_X = 100;
+s32 MAX_SIZE_TILE_Y = 100;
+s32 MIN_SIZE_TILE_X = 15;
+s32 MIN_SIZE_TILE_Y = 15;
 
 s8 weather_set;
 u8 set_tiles;
@@ -286,8 +300,8 @@ void Level_Editor_Init()
 	{
 		for (int j{}; j < MAX_SIZE_TILE_X; ++j)
 		{
-			Create_Grid[i][j].terrain_type = Map::NOTHING;
-			Create_Grid[i][j].tile_type = Map::GRASS;
+			Create_Grid[i][j].Set_Terrain_Type(Map::NOTHING);
+			Create_Grid[i][j].Set_Tile_Type(Map::GRASS);
 		}
 	}
 
@@ -296,13 +310,13 @@ void Level_Editor_Init()
 	change_which_slot = 2;
 
 	editor_objectives = {
-		{static_cast<s8>(0),static_cast<s8>(0)},
-		{static_cast<s8>(TILE_X - 1),static_cast<s8>(TILE_Y - 1)},
+		{0,0},
+		{TILE_X - 1,TILE_Y - 1},
 		10,
 		0
 	};
 
-	Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].terrain_type = Map::ENEMY;
+	Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].Set_Terrain_Type(Map::ENEMY);
 
 	popup_triggered = false;
 
@@ -314,6 +328,7 @@ void Level_Editor_Init()
 	exit_or_save = false;
 	confirmation_pop_up_triggered = false;
 	any_key_pop_up_triggered = false;
+	Stop_Level_Solver();
 	if (!ui_panel_up)
 	{
 		Open_Close_Panel();
@@ -351,7 +366,7 @@ void Level_Editor_Update()
 			if (set_draw_mode == DRAW_MODE::MULTI_DRAW)
 			{
 				if (AEInputCheckCurr(AEVK_LBUTTON)) {
-					s8 grid_x{}, grid_y{};
+					s32 grid_x{}, grid_y{};
 					Get_Mouse_Tile_Coordinates(grid_x, grid_y);
 
 					Add_Asset(grid_x, grid_y);
@@ -360,7 +375,7 @@ void Level_Editor_Update()
 			else if (set_draw_mode == DRAW_MODE::SINGLE_DRAW)
 			{
 				if (AEInputCheckTriggered(AEVK_LBUTTON)) {
-					s8 grid_x{}, grid_y{};
+					s32 grid_x{}, grid_y{};
 					Get_Mouse_Tile_Coordinates(grid_x, grid_y);
 
 					Add_Asset(grid_x, grid_y);
@@ -373,7 +388,7 @@ void Level_Editor_Update()
 			else if (set_draw_mode == DRAW_MODE::ERASE)
 			{
 				if (AEInputCheckCurr(AEVK_LBUTTON)) {
-					s8 grid_x{}, grid_y{};
+					s32 grid_x{}, grid_y{};
 					Get_Mouse_Tile_Coordinates(grid_x, grid_y);
 
 					Erase_Assets(grid_x, grid_y);
@@ -545,33 +560,33 @@ void Level_Editor_Update()
 
 							--TILE_X;
 
-							for (s8 j {}; j < TILE_Y; ++j)
+							for (s32 j {}; j < TILE_Y; ++j)
 							{
-								if (Create_Grid[j][TILE_X].terrain_type == Map::ENEMY)
+								if (Create_Grid[j][TILE_X].Get_Terrain_Type() == Map::ENEMY)
 								{
-									if (Create_Grid[j][TILE_X - 1].terrain_type != Map::NOTHING)
+									if (Create_Grid[j][TILE_X - 1].Get_Terrain_Type() != Map::NOTHING)
 									{
-										Create_Grid[j][TILE_X - 1].terrain_type = Map::NOTHING;
+										Create_Grid[j][TILE_X - 1].Set_Terrain_Type(Map::NOTHING);
 									}
-									else if (Create_Grid[j][TILE_X - 1].tile_type == Map::RIVER)
+									else if (Create_Grid[j][TILE_X - 1].Get_Tile_Type() == Map::RIVER)
 									{
-										Create_Grid[j][TILE_X - 1].tile_type = Map::GRASS;
+										Create_Grid[j][TILE_X - 1].Set_Tile_Type(Map::GRASS);
 									}
 
-									Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].terrain_type = Map::NOTHING;
-									Create_Grid[j][TILE_X - 1].terrain_type = Map::ENEMY;
+									Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].Set_Terrain_Type(Map::NOTHING);
+									Create_Grid[j][TILE_X - 1].Set_Terrain_Type(Map::ENEMY);
 									editor_objectives.arsonist_coord.first = TILE_X-1;
 									editor_objectives.arsonist_coord.second = j;
 								}
 								if (j == game_obj_stats.player_y && TILE_X == game_obj_stats.player_x)
 								{
-									if (Create_Grid[j][TILE_X - 1].terrain_type != Map::NOTHING)
+									if (Create_Grid[j][TILE_X - 1].Get_Terrain_Type() != Map::NOTHING)
 									{
-										Create_Grid[j][TILE_X - 1].terrain_type = Map::NOTHING;
+										Create_Grid[j][TILE_X - 1].Set_Terrain_Type(Map::NOTHING);
 									}
-									else if (Create_Grid[j][TILE_X - 1].tile_type == Map::RIVER)
+									else if (Create_Grid[j][TILE_X - 1].Get_Tile_Type() == Map::RIVER)
 									{
-										Create_Grid[j][TILE_X - 1].tile_type = Map::GRASS;
+										Create_Grid[j][TILE_X - 1].Set_Tile_Type(Map::GRASS);
 									}
 
 									game_obj_stats.player_x = TILE_X - 1;
@@ -586,13 +601,13 @@ void Level_Editor_Update()
 								return;
 							}
 
-							s8 y_check_ahead = TILE_Y + 1;
+							s32 y_check_ahead = TILE_Y + 1;
 							y_check_ahead = y_check_ahead > MAX_SIZE_TILE_Y ? MAX_SIZE_TILE_Y : y_check_ahead;
 							for (int k{}; k < y_check_ahead; ++k)
 							{
-								Create_Grid[k][TILE_X].terrain_type = Map::NOTHING;
-								Create_Grid[k][TILE_X].tile_type = Map::GRASS;
-								Create_Grid[k][TILE_X].fire = 0;
+								Create_Grid[k][TILE_X].Set_Terrain_Type(Map::NOTHING);
+								Create_Grid[k][TILE_X].Set_Tile_Type(Map::GRASS);
+								Create_Grid[k][TILE_X].Set_Fire(0);
 							}
 							++TILE_X;
 
@@ -606,34 +621,34 @@ void Level_Editor_Update()
 							}
 
 							--TILE_Y;
-							for (s8 l{}; l < TILE_X; ++l)
+							for (s32 l{}; l < TILE_X; ++l)
 							{
-								if (Create_Grid[TILE_Y][l].terrain_type == Map::ENEMY)
+								if (Create_Grid[TILE_Y][l].Get_Terrain_Type() == Map::ENEMY)
 								{
-									if (Create_Grid[TILE_Y - 1][l].terrain_type != Map::NOTHING)
+									if (Create_Grid[TILE_Y - 1][l].Get_Terrain_Type() != Map::NOTHING)
 									{
-										Create_Grid[TILE_Y - 1][l].terrain_type = Map::NOTHING;
+										Create_Grid[TILE_Y - 1][l].Set_Terrain_Type(Map::NOTHING);
 									}
-									else if (Create_Grid[TILE_Y - 1][l].tile_type == Map::RIVER)
+									else if (Create_Grid[TILE_Y - 1][l].Get_Tile_Type() == Map::RIVER)
 									{
-										Create_Grid[TILE_Y - 1][l].tile_type = Map::GRASS;
+										Create_Grid[TILE_Y - 1][l].Set_Tile_Type(Map::GRASS);
 									}
 
-									Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].terrain_type = Map::NOTHING;
-									Create_Grid[TILE_Y - 1][l].terrain_type = Map::ENEMY;
+									Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].Set_Terrain_Type(Map::NOTHING);
+									Create_Grid[TILE_Y - 1][l].Set_Terrain_Type(Map::ENEMY);
 									editor_objectives.arsonist_coord.first = l;
 									editor_objectives.arsonist_coord.second = TILE_Y - 1;
 								}
 
 								if (l == game_obj_stats.player_x && TILE_Y == game_obj_stats.player_y)
 								{
-									if (Create_Grid[TILE_Y - 1][l].terrain_type != Map::NOTHING)
+									if (Create_Grid[TILE_Y - 1][l].Get_Terrain_Type() != Map::NOTHING)
 									{
-										Create_Grid[TILE_Y - 1][l].terrain_type = Map::NOTHING;
+										Create_Grid[TILE_Y - 1][l].Set_Terrain_Type(Map::NOTHING);
 									}
-									else if (Create_Grid[TILE_Y - 1][l].tile_type == Map::RIVER)
+									else if (Create_Grid[TILE_Y - 1][l].Get_Tile_Type() == Map::RIVER)
 									{
-										Create_Grid[TILE_Y - 1][l].tile_type = Map::GRASS;
+										Create_Grid[TILE_Y - 1][l].Set_Tile_Type(Map::GRASS);
 									}
 
 									game_obj_stats.player_y = TILE_Y - 1;
@@ -648,13 +663,13 @@ void Level_Editor_Update()
 								return;
 							}
 
-							s8 x_check_ahead = TILE_X + 1;
+							s32 x_check_ahead = TILE_X + 1;
 							x_check_ahead = x_check_ahead > MAX_SIZE_TILE_X ? MAX_SIZE_TILE_X : x_check_ahead;
 							for (int m{}; m < x_check_ahead; ++m)
 							{
-								Create_Grid[TILE_Y][m].terrain_type = Map::NOTHING;
-								Create_Grid[TILE_Y][m].tile_type = Map::GRASS;
-								Create_Grid[TILE_Y][m].fire = 0;
+								Create_Grid[TILE_Y][m].Set_Terrain_Type(Map::NOTHING);
+								Create_Grid[TILE_Y][m].Set_Tile_Type(Map::GRASS);
+								Create_Grid[TILE_Y][m].Set_Fire(0);
 							}
 							++TILE_Y;
 						
@@ -725,7 +740,11 @@ void Level_Editor_Update()
 
 	// This section handles the inputs for confirmation popup
 	if (any_key_pop_up_triggered) {
-		if (Any_Key_Was_Pressed()) {
+		// The pop up shows the result of the save, so it stays up until the solver has one
+		if (solver_running) {
+			Check_Level_Solver();
+		}
+		else if (Any_Key_Was_Pressed()) {
 			any_key_pop_up_triggered = false;
 		}
 	}
@@ -759,7 +778,8 @@ void Level_Editor_Update()
 				{
 					if (Write_File(Create_Grid, game_obj_stats, display_objectives_list, editor_objectives, weather_set))
 					{
-						POP_UP_TEXT1 = "Your level has been saved!";
+						// Play the saved level headless to tell the designer how many stars it gives
+						Start_Level_Solver();
 					}
 					else {
 						POP_UP_TEXT1 = "Oh no! Something went wrong!";
@@ -813,7 +833,7 @@ void Level_Editor_Update()
 		if (display_objectives_list[i] == Objectives::SAVE_HOUSE)
 		{
 			if (editor_objectives.house_coord.first > TILE_X-1 || editor_objectives.house_coord.second > TILE_Y-1 
-				|| Create_Grid[editor_objectives.house_coord.second][editor_objectives.house_coord.first].terrain_type != Map::HOUSE)
+				|| Create_Grid[editor_objectives.house_coord.second][editor_objectives.house_coord.first].Get_Terrain_Type() != Map::HOUSE)
 			{
 				display_objectives_list[i] = Objectives::EMPTY;
 			}
@@ -1105,8 +1125,9 @@ void Level_Editor_Draw()
 		AEGfxPrint(p_button_font, POP_UP_TEXT1.c_str(), pop_up[0] - font_width / 2.0f, pop_up[1] - font_height / 2.0f + text_offset, 1.0f,
 			pop_up_text_color[0], pop_up_text_color[1], pop_up_text_color[2], pop_up_text_color[3]);
 
-		AEGfxGetPrintSize(p_button_font, POP_UP_TEXT2, 1.0f, &font_width, &font_height);
-		AEGfxPrint(p_button_font, POP_UP_TEXT2, pop_up[0] - font_width / 2.0f, pop_up[1] - font_height / 2.0f - text_offset, 1.0f,
+		const char* pop_up_text2 = solver_running ? SOLVING_TEXT : POP_UP_TEXT2;
+		AEGfxGetPrintSize(p_button_font, pop_up_text2, 1.0f, &font_width, &font_height);
+		AEGfxPrint(p_button_font, pop_up_text2, pop_up[0] - font_width / 2.0f, pop_up[1] - font_height / 2.0f - text_offset, 1.0f,
 			pop_up_text_color[0], pop_up_text_color[1], pop_up_text_color[2], pop_up_text_color[3]);
 	}
 
@@ -1151,10 +1172,11 @@ void Level_Editor_Unload()
 	AEGfxTextureUnload(button_hovered);
 	AEGfxTextureUnload(button_pressed);
 	Free_Map_Data();
+	Stop_Level_Solver();
 }
 
 // Function to add objects on to the map
-void Add_Asset(s8 grid_x, s8 grid_y)
+void Add_Asset(s32 grid_x, s32 grid_y)
 {
 	// To check if clicking out of bounds
 	if (grid_x < 0 || grid_y < 0 || grid_x > TILE_X || grid_y > TILE_Y)
@@ -1164,7 +1186,7 @@ void Add_Asset(s8 grid_x, s8 grid_y)
 	// Otherwise if setting terrain
 	if (set_tiles == SET_TERRAIN)
 	{
-		if (Create_Grid[grid_y][grid_x].terrain_type == Map::ENEMY || (grid_x == game_obj_stats.player_x) && (grid_y == game_obj_stats.player_y)) // Check if terrain is being set on player
+		if (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::ENEMY || (grid_x == game_obj_stats.player_x) && (grid_y == game_obj_stats.player_y)) // Check if terrain is being set on player
 		{																																		  // Return if true
 			return;
 		}
@@ -1172,25 +1194,25 @@ void Add_Asset(s8 grid_x, s8 grid_y)
 		if (terrain_to_set == Map::ENEMY) // Otherwise, if setting arsonist
 		{
 
-			if ((Create_Grid[grid_y][grid_x].tile_type != Map::GRASS) && (Create_Grid[grid_y][grid_x].tile_type != Map::DIRT) ||
-				(Create_Grid[grid_y][grid_x].terrain_type != Map::NOTHING) || (grid_x == game_obj_stats.player_x) && (grid_y == game_obj_stats.player_y)) // Check for this conditions,
+			if ((Create_Grid[grid_y][grid_x].Get_Tile_Type() != Map::GRASS) && (Create_Grid[grid_y][grid_x].Get_Tile_Type() != Map::DIRT) ||
+				(Create_Grid[grid_y][grid_x].Get_Terrain_Type() != Map::NOTHING) || (grid_x == game_obj_stats.player_x) && (grid_y == game_obj_stats.player_y)) // Check for this conditions,
 			{																																			  // If true, return
 				return;
 			}
 
-			Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].terrain_type = Map::NOTHING; // Otherwise, set the enemy on to that specified tile
-			Create_Grid[grid_y][grid_x].terrain_type = Map::ENEMY;
+			Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].Set_Terrain_Type(Map::NOTHING); // Otherwise, set the enemy on to that specified tile
+			Create_Grid[grid_y][grid_x].Set_Terrain_Type(Map::ENEMY);
 			editor_objectives.arsonist_coord.first = grid_x;
 			editor_objectives.arsonist_coord.second = grid_y;
 			Set_Objectives(BUTTON_ICONS::ARSONIST_UI); // And set the objectives 
 		}
 
-		Create_Grid[grid_y][grid_x].terrain_type = terrain_to_set; // set terrain for ordinary terrain (e.g trees and bushes)
+		Create_Grid[grid_y][grid_x].Set_Terrain_Type(terrain_to_set); // set terrain for ordinary terrain (e.g trees and bushes)
 
 		if (terrain_to_set == Map::HOUSE) // If its a house, do the following
 		{
-			Create_Grid[editor_objectives.house_coord.second][editor_objectives.house_coord.first].terrain_type = Map::NOTHING;
-			Create_Grid[grid_y][grid_x].terrain_type = Map::HOUSE;
+			Create_Grid[editor_objectives.house_coord.second][editor_objectives.house_coord.first].Set_Terrain_Type(Map::NOTHING);
+			Create_Grid[grid_y][grid_x].Set_Terrain_Type(Map::HOUSE);
 			editor_objectives.house_coord.first = grid_x;
 			editor_objectives.house_coord.second = grid_y;
 			Set_Objectives(BUTTON_ICONS::HOUSE_UI); // and set the objectives 
@@ -1202,38 +1224,38 @@ void Add_Asset(s8 grid_x, s8 grid_y)
 	else if (set_tiles == SET_TYPE) // Else if setting tile typw
 	{
 		if ((grid_x == game_obj_stats.player_x) && (grid_y == game_obj_stats.player_y) && (type_to_set == Map::RIVER) || // Check for this conditions
-			(Create_Grid[grid_y][grid_x].terrain_type == Map::ENEMY) && (type_to_set == Map::RIVER))					// If true, return
+			(Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::ENEMY) && (type_to_set == Map::RIVER))					// If true, return
 		{
 			return;
 		}
 
-		Create_Grid[grid_y][grid_x].tile_type = type_to_set; // Otherwise, set the tile type
+		Create_Grid[grid_y][grid_x].Set_Tile_Type(type_to_set); // Otherwise, set the tile type
 	}
 
 	else if (set_tiles == SET_FIRE) // Lastly, if setting fire
 	{
-		if ( (Create_Grid[grid_y][grid_x].terrain_type == Map::MOUNTAIN) || (Create_Grid[grid_y][grid_x].terrain_type == Map::HILL)  // Check for this conditions
-			|| (Create_Grid[grid_y][grid_x].tile_type == Map::RIVER) || (Create_Grid[grid_y][grid_x].terrain_type == Map::ENEMY) || // If true, return
+		if ( (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::MOUNTAIN) || (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::HILL)  // Check for this conditions
+			|| (Create_Grid[grid_y][grid_x].Get_Tile_Type() == Map::RIVER) || (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::ENEMY) || // If true, return
 			(grid_x == game_obj_stats.player_x) && (grid_y == game_obj_stats.player_y))
 		{
 			return;
 		}
 
-		Create_Grid[grid_y][grid_x].fire = fire_strength; // Otherwise, set the fire
+		Create_Grid[grid_y][grid_x].Set_Fire(fire_strength); // Otherwise, set the fire
 	}
 }
 
 // Function to place player on the map
-void Place_Player(s8 grid_x, s8 grid_y)
+void Place_Player(s32 grid_x, s32 grid_y)
 {
 	if (grid_x < 0 || grid_y < 0 || grid_x > TILE_X || grid_y > TILE_Y) // If out of range, return
 	{
 		return;
 	}
 	// Otherwise check for the following conditions
-	if ( (Create_Grid[grid_y][grid_x].terrain_type == Map::TREE) || (Create_Grid[grid_y][grid_x].terrain_type == Map::MOUNTAIN) || 
-		(Create_Grid[grid_y][grid_x].terrain_type == Map::HOUSE) || (Create_Grid[grid_y][grid_x].terrain_type == Map::ENEMY) || 
-		(Create_Grid[grid_y][grid_x].tile_type == Map::RIVER) || (Create_Grid[grid_y][grid_x].fire > 0) )
+	if ( (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::TREE) || (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::MOUNTAIN) || 
+		(Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::HOUSE) || (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::ENEMY) || 
+		(Create_Grid[grid_y][grid_x].Get_Tile_Type() == Map::RIVER) || (Create_Grid[grid_y][grid_x].Get_Fire() > 0) )
 	{
 		return;
 	}
@@ -1289,7 +1311,7 @@ void Set_Objectives(u8 objective_type, s16 time_limit, s16 tree_count)
 			{
 				if (display_objectives_list[change_which_slot] == Objectives::SAVE_HOUSE) // If the objective that is to be replaced is SAVE HOUSE, remove house on map
 				{
-					Create_Grid[editor_objectives.house_coord.second][editor_objectives.house_coord.first].terrain_type = Map::NOTHING;
+					Create_Grid[editor_objectives.house_coord.second][editor_objectives.house_coord.first].Set_Terrain_Type(Map::NOTHING);
 				}
 
 				display_objectives_list[change_which_slot] = What_To_Display; //Set the objective
@@ -1341,20 +1363,20 @@ void Open_Close_Panel()
 }
 
 // This sets draw mode to erase anything, but the player and the arsonist
-void Erase_Assets(s8 grid_x, s8 grid_y)
+void Erase_Assets(s32 grid_x, s32 grid_y)
 {
 	if (grid_x < 0 || grid_y < 0 || grid_x > TILE_X || grid_y > TILE_Y)
 	{
 		return;
 	}
-	else if (Create_Grid[grid_y][grid_x].terrain_type == Map::ENEMY)
+	else if (Create_Grid[grid_y][grid_x].Get_Terrain_Type() == Map::ENEMY)
 	{
 		return;
 	}
 
-	Create_Grid[grid_y][grid_x].tile_type = Map::GRASS;
-	Create_Grid[grid_y][grid_x].terrain_type = Map::NOTHING;
-	Create_Grid[grid_y][grid_x].fire = 0;
+	Create_Grid[grid_y][grid_x].Set_Tile_Type(Map::GRASS);
+	Create_Grid[grid_y][grid_x].Set_Terrain_Type(Map::NOTHING);
+	Create_Grid[grid_y][grid_x].Set_Fire(0);
 }
 
 // Clear all objects on the visible map
@@ -1364,12 +1386,12 @@ void Clear_Visible_Map()
 	{
 		for (int j{}; j < TILE_X; ++j)
 		{
-			if (Create_Grid[i][j].terrain_type == Map::ENEMY)
+			if (Create_Grid[i][j].Get_Terrain_Type() == Map::ENEMY)
 				continue;
 
-			Create_Grid[i][j].terrain_type = Map::NOTHING;
-			Create_Grid[i][j].tile_type = Map::GRASS;
-			Create_Grid[i][j].fire = 0;
+			Create_Grid[i][j].Set_Terrain_Type(Map::NOTHING);
+			Create_Grid[i][j].Set_Tile_Type(Map::GRASS);
+			Create_Grid[i][j].Set_Fire(0);
 		}
 	}
 }
@@ -1382,7 +1404,7 @@ s16 Total_Tree_Count()
 	{
 		for (int j{}; j < TILE_X; ++j)
 		{
-			if (Create_Grid[i][j].terrain_type == Map::TREE)
+			if (Create_Grid[i][j].Get_Terrain_Type() == Map::TREE)
 			{
 				++tree_on_map;
 			}
@@ -1405,23 +1427,23 @@ void Reset_Map_Size()
 
 		if (editor_objectives.arsonist_coord.first > MIN_SIZE_TILE_X || editor_objectives.arsonist_coord.second > MIN_SIZE_TILE_Y) // Set arsonist to original position, and check
 		{																															// if the area is passable, if not, set it to passable
-			if (Create_Grid[MIN_SIZE_TILE_Y-1][MIN_SIZE_TILE_X-1].tile_type == Map::RIVER)
+			if (Create_Grid[MIN_SIZE_TILE_Y-1][MIN_SIZE_TILE_X-1].Get_Tile_Type() == Map::RIVER)
 			{
-				Create_Grid[MIN_SIZE_TILE_Y-1][MIN_SIZE_TILE_X-1].tile_type = Map::GRASS;
+				Create_Grid[MIN_SIZE_TILE_Y-1][MIN_SIZE_TILE_X-1].Set_Tile_Type(Map::GRASS);
 			}
-			Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].terrain_type = Map::NOTHING;
-			Create_Grid[MIN_SIZE_TILE_Y-1][MIN_SIZE_TILE_X-1].terrain_type = Map::ENEMY;
+			Create_Grid[editor_objectives.arsonist_coord.second][editor_objectives.arsonist_coord.first].Set_Terrain_Type(Map::NOTHING);
+			Create_Grid[MIN_SIZE_TILE_Y-1][MIN_SIZE_TILE_X-1].Set_Terrain_Type(Map::ENEMY);
 			editor_objectives.arsonist_coord.first = MIN_SIZE_TILE_X-1;
 			editor_objectives.arsonist_coord.second = MIN_SIZE_TILE_Y-1;
 		}
 
 		if (game_obj_stats.player_x > MIN_SIZE_TILE_X || game_obj_stats.player_y > MIN_SIZE_TILE_Y) // Now handle the player 
 		{																							// If reset the player back to its original position
-			if (Create_Grid[0][0].tile_type == Map::RIVER)											// And clear whatever tile that has been placed there 
+			if (Create_Grid[0][0].Get_Tile_Type() == Map::RIVER)											// And clear whatever tile that has been placed there 
 			{
-				Create_Grid[0][0].tile_type = Map::GRASS;
+				Create_Grid[0][0].Set_Tile_Type(Map::GRASS);
 			}
-			Create_Grid[0][0].terrain_type = Map::NOTHING;
+			Create_Grid[0][0].Set_Terrain_Type(Map::NOTHING);
 			game_obj_stats.player_x = 0;
 			game_obj_stats.player_y = 0;
 		}
@@ -1437,3 +1459,57 @@ void Free_Map_Data()
 
 	delete[] Create_Grid;
 }
+
+// Function to start solving the level just saved, on a thread of its own so the editor keeps drawing
+void Start_Level_Solver()
+{
+	Stop_Level_Solver();
+	POP_UP_TEXT1 = "Saved! Looking for a way to win it...";
+	solver_done = false;
+	solver_running = true;
+	std::string level = Editor_Level_File();
+	solver_thread = std::thread{ [level]()
+		{
+			solver_loaded = level_solver.Solve(level);
+			solver_done = true;
+		} };
+}
+
+// Function to show how far the solver got, and the stars it found once it finished
+void Check_Level_Solver()
+{
+	if (!solver_done)
+	{
+		POP_UP_TEXT1 = "Saved! Looking for a way to win it... " + std::to_string(level_solver.Get_States_Searched()) + " states played";
+		return;
+	}
+
+	solver_thread.join();
+	solver_running = false;
+	u8 stars{};
+	if (solver_loaded)
+	{
+		stars = level_solver.Get_Max_Stars();
+		for (Solver_Result const& result : level_solver.Get_Results())
+		{
+			if (result.achievable && result.stars == stars)
+			{
+				Replay witness{ result.witness };
+				witness.Save(SOLUTION_FILE_PATH);
+				break;
+			}
+		}
+	}
+	POP_UP_TEXT1 = stars ? "Saved! It can be won with " + std::to_string(stars) + " stars!"
+		: "Saved, but no way to win it was found!";
+}
+
+// Function to wait for a solver still running, when the editor resets or closes its result is not shown
+void Stop_Level_Solver()
+{
+	if (solver_thread.joinable())
+	{
+		solver_thread.join();
+	}
+	solver_running = false;
+}
@@ -70,18 +70,18 @@ struct buttons {
 
 struct Editor_Objectives
 {
-	std::pair<s8, s8> house_coord;
-	std::pair<s8, s8> arsonist_coord;
+	std::pair<s32, s32> house_coord;
+	std::pair<s32, s32> arsonist_coord;
 	s16 time_limit{};
 	s16 tree_count{};
 };
 
 struct Game_object_Stats
 {
-	s8 TILE_WIDTH;
-	s8 TILE_HEIGHT;
-	s8 player_x;
-	s8 player_y;
+	s32 TILE_WIDTH;
+	s32 TILE_HEIGHT;
+	s32 player_x;
+	s32 player_y;
 };
 
 struct Editor_Asset
@@ -135,12 +135,15 @@ void Level_Editor_Draw();
 void Level_Editor_Free();
 void Level_Editor_Unload();
 
-void Add_Asset(s8 grid_x, s8 grid_y);
-void Erase_Assets(s8 grid_x, s8 grid_y);
-void Place_Player(s8 grid_x, s8 grid_y);
+void Add_Asset(s32 grid_x, s32 grid_y);
+void Erase_Assets(s32 grid_x, s32 grid_y);
+void Place_Player(s32 grid_x, s32 grid_y);
 void Clear_Visible_Map();
 void Reset_Map_Size();
 s16 Total_Tree_Count();
 void Set_Objectives(u8 objective_type, s16 time_limit = 0, s16 tree_count = 0);
 void Open_Close_Panel();
-void Free_Map_Data();
\ No newline at end of file
+void Free_Map_Data();
+void Start_Level_Solver();
+void Check_Level_Solver();
+void Stop_Level_Solver();
\ No newline at end of file
@@ -5,7 +5,9 @@
 \par    	Email: zhenhao.ho@digipen.edu
 \par    	Project: Forest Force
 \date   	April 06, 2024
-\brief		This file contains the core game loop.
+\brief		This file contains the core game loop. Started with
+			--replay <file> it plays the replay headless instead and exits
+			with 0 if it ended the way it was recorded.
 
 Copyright (C) 2024 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents without the
@@ -16,6 +18,9 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "pch.hpp"
 #include "System.hpp"
 #include "GameStateManager.hpp"
+#include "File_Load.hpp"
+#include "Thread_Pool.hpp"
+#include "Replay.hpp"
 
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
     _In_opt_ HINSTANCE hPrevInstance,
@@ -29,7 +34,25 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
 
     /// System Init Code
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
+
+    // Play a replay headless to check it still ends the way it was recorded
+    std::wstring command_line{ lpCmdLine ? lpCmdLine : L"" };
+    std::wstring const replay_flag{ L"--replay " };
+    if (command_line.compare(0, replay_flag.size(), replay_flag) == 0)
+    {
+        std::string replay_file{};
+        for (wchar_t letter : command_line.substr(replay_flag.size()))
+        {
+            if (letter != L'"')
+                replay_file += static_cast<char>(letter);
+        }
+        Load_Game_Parameters();
+        thread_pool.Start();
+        bool const matched{ Check_Replay(replay_file) };
+        thread_pool.Stop();
+        return matched ? 0 : 1;
+    }
+
     // Using custom window procedure (also determines console spawning)
     AESysInit(hInstance, nCmdShow, WINDOW_LENGTH, WINDOW_WIDTH, 0, 60, true, NULL);
     System_Initialize();
@@ -7,6 +7,9 @@
 \date   	April 06, 2024
 \brief		This file contains the Map class. Map class contains the main game
 			logic of the environmental simulation of Forest Force.
+			The grids are double buffered with a halo around them, and a tick
+			only updates the tiles around the ones that changed last tick,
+			split into bands across the thread pool.
 			The main functions of Map.cpp are:
 			-Tile_Asset_Load
 				Loads Assets to draw the Map of Forest Force
@@ -16,10 +19,29 @@
 				Dynamically allocates Tiles array for Map of Forest Force
 			-Map_Init
 				Initialises the double buffer Tiles arrays and other Map related objects
-			-Map_Update
+			-Queue_Command
+				Queues a spell effect to be applied at the start of the next tick
+			-Simulate_Tick
 				Updates an alternating double buffers with game logic
+			-Run_Ticks / Run_Until_Quiescent
+				Runs the simulation headless, as fast as the CPU allows
+			-Take_Snapshot / Restore_Snapshot
+				Saves the Map and puts it back later, copying only the tiles
+				written since
+			-Rewind
+				Steps the simulation back through the ticks kept in the rewind ring
+			-Get_Fire_Arrival
+				Ticks until fire is expected on a tile, kept up to date every tick
+			-Clone_From
+				Copies the simulation state of another Map, reusing the grids
+			-Get_State_Hash
+				Zobrist hash of the Map's state, kept up to date by every tile write
+			-Get_Plane
+				Bit planes of the burning, wet, passable and near fire tiles
 			-Map_Unload
 				Frees Tiles array for Map of Forest Force
+			Define FIRE_ARRIVAL_CHECK in a debug build to assert after every
+			tick that the repaired fire arrival field matches a rebuilt one.
 Copyright (C) 2024 DigiPen Institute of Technology.
 Reproduction or disclosure of this file or its contents without the
 prior written consent of DigiPen Institute of Technology is prohibited.
@@ -27,19 +49,119 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 /******************************************************************************/
 #include "pch.hpp"
 #include "Map.hpp"
-#include "Player.hpp"
-#include "Level.hpp"
-#include "Audio.hpp"
-
-Map level_map{};
+#include "Thread_Pool.hpp"
+#include <new>							// Aligned operator new for the tile grids
+#include <memory>						// std::uninitialized_fill_n
+#include <algorithm>					// std::copy_n
+#include <cmath>						// std::ceil
 
 Tile_Asset map_asset;
 
 //Annonymous Namespace
 namespace
 {
-	f64 behaviour_timer{};
-	f64 fire_timer{};
+	// Grids are aligned to a cache line and every row is padded to a whole
+	// number of cache lines so that neighbouring rows never share one
+	const size_t GRID_ALIGNMENT{ 64 };
+	const s32 TILES_PER_LINE{ static_cast<s32>(GRID_ALIGNMENT / sizeof(Tiles)) };
+	// Tiles the fire stencil collates at once when only part of a row is updated
+	const s32 STENCIL_RUN{ 64 };
+	// Fewest tiles given to a band of the thread pool
+	const size_t MIN_BAND_TILES{ 4096 };
+
+	/**************************************************************************/
+	/*!
+		 Packs what State_Behaviour looks at into an index of the state
+		 table. earth_level is 0 with no earth, 2 with enough earth for a
+		 mountain and 1 in between
+	*/
+	/**************************************************************************/
+	u32 State_Index(u32 terrain, bool river, bool no_wood, bool permanant, bool houses_destroyed, bool passable, u32 earth_level)
+	{
+		return terrain | static_cast<u32>(river) << 3 | static_cast<u32>(no_wood) << 4 | static_cast<u32>(permanant) << 5
+			| static_cast<u32>(houses_destroyed) << 6 | static_cast<u32>(passable) << 7 | earth_level << 8;
+	}
+
+	/**************************************************************************/
+	/*!
+		 Mixes the seed of a tick's spread rolls with a tile into 32 random
+		 bits, so every tile rolls the same whichever band updates it
+	*/
+	/**************************************************************************/
+	u32 Spread_Hash(u64 seed, s32 tile)
+	{
+		u64 mixed{ seed + static_cast<u64>(tile) * 0x9E3779B97F4A7C15ull };
+		mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+		mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+		return static_cast<u32>((mixed ^ (mixed >> 31)) >> 32);
+	}
+
+	// Slots of the Zobrist keys of the Map's counters, past any tile index
+	const u64 WIND_SLOT{ ~0ull };
+	const u64 COUNTER_SLOT{ ~1ull };
+	const u64 SPREAD_SLOT{ ~2ull };
+	const u64 POSITION_SLOT{ ~3ull };
+
+	/**************************************************************************/
+	/*!
+		 Zobrist key of a slot (a tile or a counter) holding a value. Keys
+		 are mixed from the slot and value instead of read from a table, a
+		 table with every value of every tile would not fit in memory
+	*/
+	/**************************************************************************/
+	u64 Zobrist_Key(u64 slot, u64 value)
+	{
+		u64 mixed{ slot * 0x9E3779B97F4A7C15ull ^ value * 0xC2B2AE3D27D4EB4Full };
+		mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+		mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+		return mixed ^ (mixed >> 31);
+	}
+
+	/**************************************************************************/
+	/*!
+		 Zobrist key of a tile of the Map holding a value
+	*/
+	/**************************************************************************/
+	u64 Tile_Key_Hash(s32 tile, Tiles value)
+	{
+		return Zobrist_Key(static_cast<u64>(tile), value.Get_Packed());
+	}
+
+	/**************************************************************************/
+	/*!
+		 Allocates one aligned grid of x_value * y_value tiles surrounded by
+		 a halo. Every tile starts as halo (grass, no fire) so that the 3x3
+		 stencil can read past the map edge without bounds checks
+	*/
+	/**************************************************************************/
+	Tile_Grid Allocate_Grid(s32 x_value, s32 y_value)
+	{
+		Tile_Grid grid{};
+		grid.stride = (x_value + 2 + TILES_PER_LINE - 1) / TILES_PER_LINE * TILES_PER_LINE;
+		size_t count = static_cast<size_t>(grid.stride) * static_cast<size_t>(y_value + 2);
+
+		grid.memory = static_cast<Tiles*>(::operator new[](count * sizeof(Tiles), std::align_val_t{ GRID_ALIGNMENT }));
+		Tiles halo{};
+		halo.Set_Tile_Type(Map::GRASS);
+		std::uninitialized_fill_n(grid.memory, count, halo);
+
+		grid.origin = grid.memory + grid.stride + 1;
+		return grid;
+	}
+
+	/**************************************************************************/
+	/*!
+		 Frees a grid allocated with Allocate_Grid
+	*/
+	/**************************************************************************/
+	void Free_Grid(Tile_Grid& grid)
+	{
+		if (grid.memory != nullptr)
+		{
+			::operator delete[](grid.memory, std::align_val_t{ GRID_ALIGNMENT });
+		}
+		grid = Tile_Grid{};
+	}
 }
 
 /**************************************************************************/
@@ -90,40 +212,104 @@ void Tile_Asset::Tile_Asset_Unload()
 	 Map Constructor
 */
 /**************************************************************************/
-Map::Map(s8 x_value, s8 y_value) : x_size{ x_value }, y_size{ y_value }, refer_grid{ nullptr }, display_grid{ nullptr }
+Map::Map(s32 x_value, s32 y_value) : x_size{ x_value }, y_size{ y_value }
 {
 }
 
 /**************************************************************************/
 /*!
 	 This function Loads the Map object and dynamically allocates 
-	 2D Tile arrays and initializes other map parameters
+	 the contiguous Tile grids and initializes other map parameters
 */
 /**************************************************************************/
-void Map::Map_Load(s8 x_value, s8 y_value)
+void Map::Map_Load(s32 x_value, s32 y_value)
 {
 	x_size = x_value;
 	y_size = y_value;
-	if (refer_grid == nullptr && display_grid == nullptr)
+	if (refer_grid.memory == nullptr && display_grid.memory == nullptr)
 	{
-		display_grid = new Tiles * [y_size] {};
-		refer_grid = new Tiles * [y_size] {};
-		init_grid = new Tiles * [y_size] {};
-		for (int i{}; i < y_size; ++i)
-		{
-			display_grid[i] = new Tiles[x_size]{};
-			refer_grid[i] = new Tiles[x_size]{};
-			init_grid[i] = new Tiles[x_size]{};
-		}
-		initial_display_grid = display_grid;
-		initial_refer_grid = refer_grid;
+		display_grid = Allocate_Grid(x_size, y_size);
+		refer_grid = Allocate_Grid(x_size, y_size);
+		init_grid = Allocate_Grid(x_size, y_size);
+		grid_buffer_size = static_cast<size_t>(init_grid.stride) * static_cast<size_t>(y_size + 2);
+	}
+	bands.clear();
+	snapshots.clear();
+	snapshots_held = 0;
+	first_buffer = display_grid.memory;
+	Clear_Rewind();
+	record_writes = !rewind_ring.empty();
+	active_mark.assign(static_cast<size_t>(x_size) * static_cast<size_t>(y_size), 0);
+	tile_planes.Resize(x_size, y_size);
+	if (track_fire_arrival)
+	{
+		fire_arrival.Resize(x_size, y_size);
 	}
 
 	max_wind_time = WIND_TIMER;
 	max_earth_durability = MAX_EARTH_DURABILTY;
 	max_wood_durability = MAX_WOOD_DURABILTY;
 	max_house_durability = MAX_HOUSE_DURABILTY;
+	Build_State_Table();
+}
+
+/**************************************************************************/
+/*!
+	 This function fills the state table with the terrain and passability
+	 a tile ends a tick with, for every combination of the values the
+	 rules look at. Earth is reduced to a level using the thresholds from
+	 max earth durability, decaying earth is a mountain above 3/4 of it
+	 and permanant earth above 1/2 of it
+*/
+/**************************************************************************/
+void Map::Build_State_Table()
+{
+	earth_threshold[0] = max_earth_durability / 4 * 3;
+	earth_threshold[1] = max_earth_durability / 2;
 
+	for (u32 index{}; index < STATE_TABLE_SIZE; ++index)
+	{
+		u8 terrain{ static_cast<u8>(index & Tiles::TERRAIN_MASK) };
+		bool river{ (index >> 3 & 1u) != 0 };
+		bool no_wood{ (index >> 4 & 1u) != 0 };
+		bool permanant{ (index >> 5 & 1u) != 0 };
+		bool houses_destroyed{ (index >> 6 & 1u) != 0 };
+		bool passable{ (index >> 7 & 1u) != 0 };
+		u32 earth_level{ index >> 8 };
+
+		if (terrain != ENEMY)
+		{
+			if (no_wood && (terrain == TREE || terrain == BUSH))//if becomes no wood durability and was TREE
+			{
+				terrain = NOTHING;
+				passable = !river;
+			}
+			else if (houses_destroyed && terrain == HOUSE)//if house no durability and was HOUSE
+			{
+				terrain = NOTHING;
+				passable = true;
+			}
+			if (!permanant && no_wood && terrain != HOUSE)//if no wood ,no house is present and earth can be changed
+			{
+				if (earth_level == 0)
+				{
+					terrain = NOTHING;
+					passable = !river;
+				}
+				else
+				{
+					terrain = earth_level == 2 ? MOUNTAIN : HILL;
+					passable = earth_level != 2;
+				}
+			}
+			else if (permanant)
+			{
+				terrain = earth_level == 2 ? MOUNTAIN : HILL;
+				passable = earth_level != 2;
+			}
+		}
+		state_table[index] = static_cast<u8>(terrain | static_cast<u32>(passable) << 3);
+	}
 }
 
 /**************************************************************************/
@@ -134,21 +320,42 @@ void Map::Map_Load(s8 x_value, s8 y_value)
 /**************************************************************************/
 void Map::Map_Init()
 {
-	display_grid = initial_display_grid;
-	refer_grid = initial_refer_grid;
-	for (int i{}; i < TILE_Y; ++i)
+	Clear_Rewind();
+	// Snapshots keep every tile that is about to be overwritten
+	if (snapshots_held)
 	{
-		for (int j{}; j < TILE_X; ++j)
+		for (size_t i{}; i < grid_buffer_size; ++i)
 		{
-			display_grid[i][j] = init_grid[i][j];
-			refer_grid[i][j] = init_grid[i][j];
+			if (display_grid.memory[i] != init_grid.memory[i])
+				Record_Write(display_grid.memory + i, display_grid.memory[i]);
+			if (refer_grid.memory[i] != init_grid.memory[i])
+				Record_Write(refer_grid.memory + i, refer_grid.memory[i]);
 		}
+	}
 
+	// Halo and padding are copied along with the map, one pass per buffer
+	std::copy_n(init_grid.memory, grid_buffer_size, display_grid.memory);
+	std::copy_n(init_grid.memory, grid_buffer_size, refer_grid.memory);
+
+	// Nothing is known about which tiles will change until every tile has been updated once
+	frontier.clear();
+	events.clear();
+	fire_ticks_left = 0;
+	// Wind from an air spell of the last attempt must not carry over
+	wind_direction = WIND::NO_WIND;
+	wind_timer = 0;
+	Rebuild_Burning_Tiles();
+	Rebuild_Tile_Hash();
+	tile_planes.Rebuild(display_grid);
+	{
+		std::lock_guard<std::mutex> lock{ command_mutex };
+		queued_commands.clear();
+		++state_version;
 	}
+	update_all = true;
 
 	Objective_Init();
-
-
+	Rebuild_Fire_Arrival();
 }
 
 /**************************************************************************/
@@ -159,22 +366,23 @@ void Map::Map_Init()
 /**************************************************************************/
 void Map::Map_Unload()
 {
-	if (refer_grid != nullptr && display_grid != nullptr)
-	{
-
-		for (int i{}; i < y_size; ++i)
-		{
-			delete[] display_grid[i];
-			delete[] refer_grid[i];
-			delete[] init_grid[i];
-		}
-		delete[] display_grid;
-		delete[] refer_grid;
-		delete[] init_grid;
-	}
-	refer_grid = nullptr;
-	display_grid = nullptr;
-	init_grid = nullptr;
+	Free_Grid(display_grid);
+	Free_Grid(refer_grid);
+	Free_Grid(init_grid);
+	grid_buffer_size = 0;
+	frontier.clear();
+	active_tiles.clear();
+	active_mark.clear();
+	house_tiles.clear();
+	burning_tiles.clear();
+	snapshots.clear();
+	snapshots_held = 0;
+	first_buffer = nullptr;
+	rewind_ring.assign(rewind_ring.size(), Tick_Delta{});
+	Clear_Rewind();
+	fire_arrival = Fire_Arrival{};
+	tile_hash = 0;
+	tile_planes.Clear();
 }
 
 
@@ -186,7 +394,7 @@ void Map::Map_Unload()
 /**************************************************************************/
 f64 Map::Get_Fire_Time()
 {
-	return fire_spread_time;
+	return fire_spread_ticks * BEHAVIOUR_TIME;
 }
 
 /**************************************************************************/
@@ -194,11 +402,11 @@ f64 Map::Get_Fire_Time()
 	 Accessor Function to get Tile fire value
 */
 /**************************************************************************/
-s8 Map::Get_Fire( s8 x_value,  s8 y_value)
+s8 Map::Get_Fire( s32 x_value, s32 y_value)
 {
-	if (y_value > (y_size - static_cast<s8>(1)) || y_value < static_cast<s8>(0) || x_value >(x_size - static_cast<s8>(1)) || x_value < static_cast<s8>(0))
+	if (y_value > (y_size - 1) || y_value < 0 || x_value >(x_size - 1) || x_value < 0)
 		return 0;
-	else return display_grid != nullptr ? display_grid[y_value][x_value].fire : 0;
+	else return display_grid.memory != nullptr ? display_grid[y_value][x_value].Get_Fire() : 0;
 }
 
 /**************************************************************************/
@@ -206,9 +414,9 @@ s8 Map::Get_Fire( s8 x_value,  s8 y_value)
 	 Accessor Function to get specified Tile* position of Updatable 2D Tile array
 */
 /**************************************************************************/
-Tiles* Map::Get_Tile( s8 x_value,  s8 y_value)
+Tiles* Map::Get_Tile( s32 x_value, s32 y_value)
 {
-	return display_grid != nullptr ? &display_grid[y_value][x_value] : nullptr;
+	return display_grid.memory != nullptr ? &display_grid[y_value][x_value] : nullptr;
 }
 
 /**************************************************************************/
@@ -216,11 +424,11 @@ Tiles* Map::Get_Tile( s8 x_value,  s8 y_value)
 	 Accessor Function to get specified Tile is passable
 */
 /**************************************************************************/
-bool Map::Get_Passable( s8 x_value,  s8 y_value)
+bool Map::Get_Passable( s32 x_value, s32 y_value)
 {
-	if (y_value > (y_size - static_cast<s8>(1)) || y_value < static_cast<s8>(0) || x_value >(x_size - static_cast<s8>(1)) || x_value < static_cast<s8>(0))
+	if (y_value > (y_size - 1) || y_value < 0 || x_value >(x_size - 1) || x_value < 0)
 		return 0;
-	else return display_grid != nullptr ? display_grid[y_value][x_value].is_passable : 0;
+	else return display_grid.memory != nullptr ? display_grid[y_value][x_value].Is_Passable() : 0;
 }
 
 /**************************************************************************/
@@ -228,12 +436,17 @@ bool Map::Get_Passable( s8 x_value,  s8 y_value)
 	 Mutator Function to set specified Tile fire value
 */
 /**************************************************************************/
-void Map::Set_Fire( s8 x_value,  s8 y_value, s8 fire_value)
+void Map::Set_Fire( s32 x_value, s32 y_value, s8 fire_value)
 {
 
-	if (display_grid[y_value][x_value].terrain_type < Map::HILL && display_grid[y_value][x_value].tile_type != RIVER)
+	if (display_grid[y_value][x_value].Get_Terrain_Type() < Map::HILL && display_grid[y_value][x_value].Get_Tile_Type() != RIVER)
 	{
-		display_grid[y_value][x_value].fire = fire_value;
+		Tiles const old_value{ display_grid[y_value][x_value] };
+		Record_Write(&display_grid[y_value][x_value], old_value);
+		display_grid[y_value][x_value].Set_Fire(fire_value);
+		tile_hash ^= Tile_Key_Hash(y_value * x_size + x_value, old_value) ^ Tile_Key_Hash(y_value * x_size + x_value, display_grid[y_value][x_value]);
+		tile_planes.Set_Tile(x_value, y_value, display_grid[y_value][x_value]);
+		Mark_Active(x_value, y_value);
 	}
 }
 
@@ -243,12 +456,12 @@ void Map::Set_Fire( s8 x_value,  s8 y_value, s8 fire_value)
 	 Mutator fuction that set fire for init_grid
 */
 /**************************************************************************/
-void Map::Set_Init_Fire( s8 x_value,  s8 y_value, s8 fire_value)
+void Map::Set_Init_Fire( s32 x_value, s32 y_value, s8 fire_value)
 {
 
-	if (init_grid[y_value][x_value].terrain_type < Map::HILL && init_grid[y_value][x_value].tile_type != RIVER)
+	if (init_grid[y_value][x_value].Get_Terrain_Type() < Map::HILL && init_grid[y_value][x_value].Get_Tile_Type() != RIVER)
 	{
-		init_grid[y_value][x_value].fire = fire_value;
+		init_grid[y_value][x_value].Set_Fire(fire_value);
 	}
 }
 
@@ -273,26 +486,127 @@ u8 Map::Get_Wind()
 	return wind_direction;
 }
 
+/**************************************************************************/
+/*!
+	 This function sets the chance that fire spreading onto a tile that is
+	 not burning catches, on each fire spread tick. 1 or more always
+	 catches, like the rules without it. Rolls are drawn from seed, the
+	 same seed plays out the same fire
+*/
+/**************************************************************************/
+void Map::Set_Spread_Chance(f32 chance, u64 seed)
+{
+	random_spread = chance < 1.0f;
+	spread_threshold = chance <= 0.0f ? 0u : static_cast<u32>(static_cast<f64>(chance) * 4294967296.0);
+	spread_roll = seed;
+}
+
+/**************************************************************************/
+/*!
+	 This function rolls whether fire spreading onto a tile this tick
+	 catches
+*/
+/**************************************************************************/
+bool Map::Spread_Roll(s32 x_value, s32 y_value)
+{
+	return Spread_Roll(spread_roll, x_value, y_value);
+}
+
+/**************************************************************************/
+/*!
+	 This function rolls whether fire spreading onto a tile catches, with
+	 the rolls of another seed than this Map's own
+*/
+/**************************************************************************/
+bool Map::Spread_Roll(u64 seed, s32 x_value, s32 y_value)
+{
+	return !random_spread || Spread_Hash(seed, y_value * x_size + x_value) < spread_threshold;
+}
+
+/**************************************************************************/
+/*!
+	 This function records a spell effect to be applied at the start of the
+	 next tick. It only takes the queue lock, so spells can be cast while
+	 the tick runs on another thread
+*/
+/**************************************************************************/
+void Map::Queue_Command(u8 command, s32 x_value, s32 y_value, s8 value)
+{
+	std::lock_guard<std::mutex> lock{ command_mutex };
+	queued_commands.push_back(Map_Command{ command, x_value, y_value, value });
+	++state_version;
+}
+
+/**************************************************************************/
+/*!
+	 This function applies every queued spell effect in the order they were
+	 cast, before the grids are swapped for the tick. Commands for tiles
+	 outside the Map are dropped
+*/
+/**************************************************************************/
+void Map::Apply_Commands()
+{
+	{
+		std::lock_guard<std::mutex> lock{ command_mutex };
+		std::swap(queued_commands, applying_commands);
+		++state_version;
+	}
+
+	for (Map_Command const& command : applying_commands)
+	{
+		if (command.command == SET_WIND)
+		{
+			Set_Wind(static_cast<u8>(command.value));
+			continue;
+		}
+		if (command.x < 0 || command.x >= x_size || command.y < 0 || command.y >= y_size)
+			continue;
+
+		if (command.command == SET_FIRE)
+			Set_Fire(command.x, command.y, command.value);
+		else if (command.command == SET_EARTH)
+			Set_Earth(command.x, command.y);
+	}
+	applying_commands.clear();
+}
+
+/**************************************************************************/
+/*!
+	 This function checks if any spell effects are waiting for the next tick
+*/
+/**************************************************************************/
+bool Map::Has_Commands()
+{
+	std::lock_guard<std::mutex> lock{ command_mutex };
+	return !queued_commands.empty();
+}
+
 /**************************************************************************/
 /*!
 	 Mutator fuction that set specified Tile earth value and earth related
 	 parameters
 */
 /**************************************************************************/
-void Map::Set_Earth( s8 x_value,  s8 y_value)
+void Map::Set_Earth( s32 x_value, s32 y_value)
 {
-	if (display_grid[y_value][x_value].terrain_type != Map::ENEMY)
-	{	display_grid[y_value][x_value].is_earth_permanant = false;
-		refer_grid[y_value][x_value].is_earth_permanant = false;
+	if (display_grid[y_value][x_value].Get_Terrain_Type() != Map::ENEMY)
+	{	Tiles const old_value{ display_grid[y_value][x_value] };
+		Record_Write(&display_grid[y_value][x_value], old_value);
+		Record_Write(&refer_grid[y_value][x_value], refer_grid[y_value][x_value]);
+		display_grid[y_value][x_value].Set_Earth_Permanant(false);
+		refer_grid[y_value][x_value].Set_Earth_Permanant(false);
 		
-		display_grid[y_value][x_value].earth_durability = max_earth_durability;
-		display_grid[y_value][x_value].wood_durability = 0;
-		display_grid[y_value][x_value].terrain_type = MOUNTAIN;
+		display_grid[y_value][x_value].Set_Earth_Durability(max_earth_durability);
+		display_grid[y_value][x_value].Set_Wood_Durability(0);
+		display_grid[y_value][x_value].Set_Terrain_Type(MOUNTAIN);
 
-		if (display_grid[y_value][x_value].terrain_type == HOUSE)
+		if (display_grid[y_value][x_value].Get_Terrain_Type() == HOUSE)
 			house_durability = 0;
-		if (display_grid[y_value][x_value].terrain_type == TREE)
+		if (display_grid[y_value][x_value].Get_Terrain_Type() == TREE)
 			--tree_count;
+		tile_hash ^= Tile_Key_Hash(y_value * x_size + x_value, old_value) ^ Tile_Key_Hash(y_value * x_size + x_value, display_grid[y_value][x_value]);
+		tile_planes.Set_Tile(x_value, y_value, display_grid[y_value][x_value]);
+		Mark_Active(x_value, y_value);
 	}
 }
 
@@ -300,102 +614,34 @@ void Map::Set_Earth( s8 x_value,  s8 y_value)
 /**************************************************************************/
 /*!
 	 this function updates the fire/water spread and fire/water interactions
-	 with other terrain types
+	 with other terrain types. The fire/water around the tile is collated
+	 into totals by a stencil before this is called. Trees and houses
+	 burnt are added to the counters passed in, the caller merges them at
+	 the end of the tick
 */
 /**************************************************************************/
-void Map::Fire_Behaviour( s8 x_value,  s8 y_value)
+void Map::Fire_Behaviour(Tiles const& refer, Tiles& update, Fire_Totals const& totals, bool fire_spread, bool houses_standing,
+	s32& trees_burnt, s32& house_damage)
 {
-	Tiles& refer = refer_grid[y_value][x_value];
-	Tiles& update = display_grid[y_value][x_value];
 	bool is_river{};
-	s8 temp_fire{};
 	s8 fire_count{};
 	s8 water_count{};
 	s8 max_water{};
 	s8 max_fire{};
-	s8 raw_wood{ refer.wood_durability };
+	s8 raw_wood{ refer.Get_Wood_Durability() };
 	s8 raw_fire{};
 
 	//1.) Don't Update Fire if current Tile is River/Mountain/Hill/Enemy
-	if (refer.tile_type != RIVER && refer.terrain_type < Map::HILL)
+	if (refer.Get_Tile_Type() != RIVER && refer.Get_Terrain_Type() < Map::HILL)
 	{
-		//2.1) Uses 2 for loops to check surrounding 3 x 3 tiles around the center tile
-		for (int j{ -1 }; j < 2; j++)
-		{
-			//2.2)Reading Out of Bounds Check
-			if (((j + y_value) > (y_size - 1)) || ((j + y_value) < 0))continue;
-			for (int i{ -1 }; i < 2; i++)
-			{
-				//2.3)Reading Out of Bounds Check
-				if (((i + x_value) > (x_size - 1)) || ((i + x_value) < 0))continue;
-				//2.4)Gets Fire value of tiles within 3x3 block
-				temp_fire = refer_grid[y_value + j][x_value + i].fire;
-				//2.5)Checks if Current tile is next to river within 3x3 block
-				if (refer_grid[y_value + j][x_value + i].tile_type == RIVER)is_river = true;
-				// 3.)Checks if Fire/Water is present on this tile, Collates total Fire/Water values in 3x3
-				//  Tiles may be skipped due to Wind behaviour or Out of Bound from above checks
-				if (temp_fire)
-				{
-					if (temp_fire < 0)
-					{
-						if (!j || !i)//checks in + shape for water 
-						{
-							max_water += temp_fire;
-							++water_count;
-						}
-					}
-					else
-					{
-
-						switch (level_map.wind_direction)
-						{
-						case(WIND::NO_WIND):
-							if (!j|| !i)//No wind check + shape for fire
-							{
-								max_fire += temp_fire;
-								++fire_count;
-							}
-							break;
-						case(WIND::UP):
-							if (j == -1 || (!i && !j))//Wind Direction Up
-							{
-								max_fire += temp_fire;
-								++fire_count;
-							}
-							break;
-						case(WIND::DOWN):
-							if (j == 1 || (!i && !j))//Wind Direction Down
-							{
-								max_fire += temp_fire;
-								++fire_count;
-							}
-							break;
-						case(WIND::LEFT):
-							if (i == 1 || (!i && !j))//Wind Direction Left
-							{
-								max_fire += temp_fire;
-								++fire_count;
-							}
-							break;
-						case(WIND::RIGHT):
-							if (i == -1 || (!i && !j))//Wind Direction Right
-							{
-								max_fire += temp_fire;
-								++fire_count;
-							}
-							break;
-						default:
-							if (!j || !i)//Guard
-							{
-								max_fire += temp_fire;
-								++fire_count;
-							}
-							break;
-						}
-					}
-				}
-			}
-		}
+		//2.)Checks if Current tile is next to river within 3x3 block
+		is_river = totals.near_river;
+		// 3.)Total Fire/Water values in 3x3, Water is collated in a + shape and
+		//  Fire in the shape given by the Wind
+		max_fire = totals.fire_sum;
+		fire_count = totals.fire_count;
+		max_water = totals.water_sum;
+		water_count = totals.water_count;
 		// 4.)Determines the Raw Fire value of the center tile by summating the postive values(Fire) and negative values(Water)
 		//	  To allow Water to be dominant, WATER_STRENGTH_MUTIPLIER is used
 		raw_fire = max_water * WATER_STRENGTH_MULTIPLER + max_fire;
@@ -403,25 +649,24 @@ void Map::Fire_Behaviour( s8 x_value,  s8 y_value)
 		// 5.)Calculates the final Fire/Water behaviour of the current tile based on the Raw Fire Value
 		if (raw_fire != 0)// if Raw fire is not 0
 		{
-			raw_wood = raw_fire > 0 ? refer.wood_durability - refer.fire : refer.wood_durability;//reduce wood durability if fire is present
-			if (raw_wood <= 0 && refer.wood_durability > 0 && refer.terrain_type == TERRAIN::TREE)//If was tree and fire burn finish
+			raw_wood = raw_fire > 0 ? refer.Get_Wood_Durability() - refer.Get_Fire() : refer.Get_Wood_Durability();//reduce wood durability if fire is present
+			if (raw_wood <= 0 && refer.Get_Wood_Durability() > 0 && refer.Get_Terrain_Type() == TERRAIN::TREE)//If was tree and fire burn finish
 			{
-				--tree_count;
+				++trees_burnt;
 
 			}
 			raw_wood = raw_wood < 0 ? 0 : raw_wood;//Prevent wood durability from going negative
-			if (refer.terrain_type == HOUSE)
+			if (refer.Get_Terrain_Type() == HOUSE)
 			{
 
-				house_durability = raw_fire > 0 ? house_durability - refer.fire : house_durability;
-				house_durability = house_durability < 0 ? 0 : house_durability;
+				house_damage = raw_fire > 0 ? house_damage + refer.Get_Fire() : house_damage;
 				
 			}
 			if (raw_fire > 0)// else if fire wins
 			{
-				if (Fire_Check())//check if fire can spread
+				if (fire_spread)//check if fire can spread
 				{
-					if (raw_wood > 0 || (refer.terrain_type == HOUSE && Get_Curr_House_Durability()))//checks presence of wood or house
+					if (raw_wood > 0 || (refer.Get_Terrain_Type() == HOUSE && houses_standing))//checks presence of wood or house
 					{
 						if (!max_water)//if theres wood AND no water , fire grows bigger
 						{
@@ -440,14 +685,14 @@ void Map::Fire_Behaviour( s8 x_value,  s8 y_value)
 				}
 				else//don't update fire if not time to spread
 				{
-					raw_fire = refer.fire;
+					raw_fire = refer.Get_Fire();
 				}
 			}
 			else if (raw_fire < 0)// else if water wins
 			{
-				if (is_river && refer.fire < -2)//River is present and water is max water
+				if (is_river && refer.Get_Fire() < -2)//River is present and water is max water
 				{
-					raw_fire = refer.fire;
+					raw_fire = refer.Get_Fire();
 				}
 				else if (max_fire)//Water wins but there fire so no need to manually reduce water level
 				{
@@ -464,63 +709,51 @@ void Map::Fire_Behaviour( s8 x_value,  s8 y_value)
 		// 6.)Fire Indicator update 
 		if (max_fire && !max_water)
 		{
-			update.is_near_fire = true;
+			update.Set_Near_Fire(true);
 		}
 		else
 		{
-			update.is_near_fire = false;
+			update.Set_Near_Fire(false);
 		}
 
 		//Caps fire to [-3,3]
 		raw_fire = raw_fire > MAX_FIRE_VALUE  ? MAX_FIRE_VALUE : raw_fire;
 		raw_fire = raw_fire < -MAX_WATER_VALUE ? -MAX_WATER_VALUE : raw_fire;
-		update.fire = (raw_fire);
-		update.wood_durability = (raw_wood);
+		update.Set_Fire(raw_fire);
+		update.Set_Wood_Durability(raw_wood);
 	}
 	// 7.)Prevents Fire from existing on Tiles with Earth(HILLS/MOUNTAIN)  
-	if (refer.earth_durability > 0)
+	if (refer.Get_Earth_Durability() > 0)
 	{
-		update.fire = 0;
-		update.wood_durability = 0;
-		update.is_near_fire = false;
+		update.Set_Fire(0);
+		update.Set_Wood_Durability(0);
+		update.Set_Near_Fire(false);
 	}
 }
 
 /**************************************************************************/
 /*!
-	 this function updates the earth behaviour of double buffer Tile grid
+	 this function updates the earth behaviour of a tile, earth that is
+	 not permanant wears down by 2 every tick
 */
 /**************************************************************************/
-void Map::Earth_Behaviour( s8 x_value,  s8 y_value)
+void Map::Earth_Behaviour(Tiles const& refer, Tiles& update)
 {
-	Tiles& refer = refer_grid[y_value][x_value];
-	Tiles& update = display_grid[y_value][x_value];
-	s8 raw_earth = refer.earth_durability;
-	if (!refer.is_earth_permanant)
-	{
-		if (raw_earth > 0)
-		{
-			raw_earth -= 2;
-
-			raw_earth = raw_earth > 0 ? raw_earth : 0;
-		}
-		update.earth_durability = raw_earth;
-	}
-
+	s32 raw_earth{ refer.Get_Earth_Durability() };
+	s32 worn_earth{ std::max(raw_earth - 2, std::min(raw_earth, 0)) };
+	update.Set_Earth_Durability(static_cast<s8>(refer.Is_Earth_Permanant() ? update.Get_Earth_Durability() : worn_earth));
 }
 
 /**************************************************************************/
 /*!
-	 this function updates the wind behaviour of double buffer Tile grid
+	 this function counts down the wind by one tick, the wind stops once
+	 its time is up
 */
 /**************************************************************************/
 void Map::Wind_Behaviour()
 {
-	if (wind_timer > 0)
-	{
-		wind_timer -= delta_time;
-	}
-	else
+	wind_timer -= BEHAVIOUR_TIME;
+	if (wind_timer <= 0)
 	{
 		wind_direction = WIND::NO_WIND;
 	}
@@ -528,78 +761,20 @@ void Map::Wind_Behaviour()
 
 /**************************************************************************/
 /*!
-	 this function updates the tile state of double buffer Tile grid
+	 this function updates the terrain and passability of a tile from the
+	 state table built by Build_State_Table
 */
 /**************************************************************************/
-void Map::State_Behaviour(s8 x_value, s8 y_value)
+void Map::State_Behaviour(Tiles& update, bool houses_destroyed)
 {
-	Tiles& update = display_grid[y_value][x_value];
-	bool river = update.tile_type == RIVER;//check presence of river
-
-
-	if(update.terrain_type != ENEMY)
-	{
-		if (update.wood_durability == 0 && (update.terrain_type == TREE || update.terrain_type == BUSH))//if becomes no wood durability and was TREE
-		{
-			update.terrain_type = NOTHING;
-			if (river)//if River
-			{
-				update.is_passable = 0;
-			}
-			else
-			{
-				update.is_passable = 1;
-			}
-		}
-		else if (house_durability == 0 && update.terrain_type == HOUSE)//if house no durability and was HOUSE
-		{
-			update.terrain_type = NOTHING;
-			update.is_passable = 1;
-		}
-		if (!update.is_earth_permanant && update.wood_durability == 0 && update.terrain_type != HOUSE)//if no wood ,no house is present and earth can be changed
-		{
-			if (update.earth_durability > 0)//if theres earth
-			{
-				if (update.earth_durability > max_earth_durability / 4 * 3)
-				{
-					update.terrain_type = MOUNTAIN;
-					update.is_passable = 0;
-				}
-				else
-				{
-					update.terrain_type = HILL;
-					update.is_passable = 1;
-				}
-			}
-			else
-			{
-				update.terrain_type = NOTHING;
-				if (river)
-				{
-					update.is_passable = 0;
-				}
-				else
-				{
-					update.is_passable = 1;
-				}
-			}
-		}
-		else if (update.is_earth_permanant)
-		{
-			if (update.earth_durability > max_earth_durability / 2)
-			{
-
-				update.terrain_type = MOUNTAIN;
-				update.is_passable = 0;
-			}
-			else
-			{
-				update.terrain_type = HILL;
-				update.is_passable = 1;
-			}
-		}
-	}
-
+	s32 earth{ update.Get_Earth_Durability() };
+	bool permanant{ update.Is_Earth_Permanant() };
+	u32 earth_level{ static_cast<u32>(earth > 0) + static_cast<u32>(earth > earth_threshold[permanant]) };
+	u8 state{ state_table[State_Index(update.Get_Terrain_Type(), update.Get_Tile_Type() == RIVER, update.Get_Wood_Durability() == 0,
+		permanant, houses_destroyed, update.Is_Passable(), earth_level)] };
+
+	update.Set_Terrain_Type(state & Tiles::TERRAIN_MASK);
+	update.Set_Passable((state >> 3) != 0);
 }
 
 /**************************************************************************/
@@ -608,67 +783,67 @@ void Map::State_Behaviour(s8 x_value, s8 y_value)
 	 Tile Init grid
 */
 /**************************************************************************/
-void Map::Tile_Init(s8 type,  s8 x_value,  s8 y_value, u8 terrain)
+void Map::Tile_Init(s8 type,  s32 x_value, s32 y_value, u8 terrain)
 {
 
 	Tiles& init = init_grid[y_value][x_value];
-	init.tile_type = type;
+	init.Set_Tile_Type(type);
 
 
-	init.terrain_type = terrain;
+	init.Set_Terrain_Type(terrain);
 
-	if (init.tile_type == GRASS || init.tile_type == DIRT)
+	if (init.Get_Tile_Type() == GRASS || init.Get_Tile_Type() == DIRT)
 	{
-		init.is_passable = 1;
+		init.Set_Passable(1);
 	}
 
-	switch (init.terrain_type)
+	switch (init.Get_Terrain_Type())
 	{
 	case(NOTHING):
-		init.earth_durability = 0;
-		init.wood_durability = 0;
-		init.is_passable = 1;
+		init.Set_Earth_Durability(0);
+		init.Set_Wood_Durability(0);
+		init.Set_Passable(1);
 		break;
 	case(HILL):
-		init.earth_durability = max_earth_durability / 2;
-		init.is_passable = 1;
-		init.is_earth_permanant = 1;
+		init.Set_Earth_Durability(max_earth_durability / 2);
+		init.Set_Passable(1);
+		init.Set_Earth_Permanant(1);
 		break;
 	case(MOUNTAIN):
-		init.earth_durability = max_earth_durability;
-		init.is_passable = 0;
-		init.is_earth_permanant = 1;
+		init.Set_Earth_Durability(max_earth_durability);
+		init.Set_Passable(0);
+		init.Set_Earth_Permanant(1);
 		break;
 	case(BUSH):
-		init.earth_durability = 0;
-		init.wood_durability = max_wood_durability/3;
-		init.is_passable = 1;
+		init.Set_Earth_Durability(0);
+		init.Set_Wood_Durability(max_wood_durability/3);
+		init.Set_Passable(1);
 		break;
 	case(TREE):
-		init.earth_durability = 0;
-		init.wood_durability = max_wood_durability;
-		init.is_passable = 0;
+		init.Set_Earth_Durability(0);
+		init.Set_Wood_Durability(max_wood_durability);
+		init.Set_Passable(0);
 		break;
 	case(HOUSE):
-		init.earth_durability = 0;
-		init.wood_durability = 0;
-		init.is_passable = 0;
+		init.Set_Earth_Durability(0);
+		init.Set_Wood_Durability(0);
+		init.Set_Passable(0);
 		break;
 	case(ENEMY):
-		init.earth_durability = 0;
-		init.wood_durability = 0;
-		init.is_passable = 1;
+		init.Set_Earth_Durability(0);
+		init.Set_Wood_Durability(0);
+		init.Set_Passable(1);
 		break;
 	default:
 		break;
 	}
 
-	if (init.tile_type == RIVER)
+	if (init.Get_Tile_Type() == RIVER)
 	{
-		init.is_passable = 0;
+		init.Set_Passable(0);
 	}
 
-	init.fire = 0;
+	init.Set_Fire(0);
 }
 
 /**************************************************************************/
@@ -676,7 +851,7 @@ void Map::Tile_Init(s8 type,  s8 x_value,  s8 y_value, u8 terrain)
 	 Accessor Function to tree count
 */
 /**************************************************************************/
-s16 Map::Wood_Count()
+s32 Map::Wood_Count()
 {
 	return tree_count;
 }
@@ -692,16 +867,16 @@ void Map::Weather_Init(u8 weather)
 	switch (map_weather)
 	{
 	case(CLOUDY):
-		fire_spread_time = BEHAVIOUR_TIME * 3.0;
+		fire_spread_ticks = 3;
 		break;
 	case(CLEAR):
-		fire_spread_time = BEHAVIOUR_TIME * 2.0;
+		fire_spread_ticks = 2;
 		break;
 	case(SUNNY):
-		fire_spread_time = BEHAVIOUR_TIME;
+		fire_spread_ticks = 1;
 		break;
 	default:
-		fire_spread_time = BEHAVIOUR_TIME * 2.0;
+		fire_spread_ticks = 2;
 		break;
 	}
 }
@@ -716,14 +891,19 @@ void Map::Objective_Init()
 {
 	tree_count = 0;
 	house_durability = 0;
-	if (refer_grid != nullptr || !tree_count) 
+	house_tiles.clear();
+	if (init_grid.memory != nullptr) 
 	{
 		for (int i{}; i < y_size; ++i)
 		{
 			for (int j{}; j < x_size; ++j)
 			{
-				if (init_grid[i][j].terrain_type == TREE)++tree_count;
-				if (init_grid[i][j].terrain_type == HOUSE)house_durability = max_house_durability;
+				if (init_grid[i][j].Get_Terrain_Type() == TREE)++tree_count;
+				if (init_grid[i][j].Get_Terrain_Type() == HOUSE)
+				{
+					house_durability = max_house_durability;
+					house_tiles.push_back(i * x_size + j);
+				}
 			}
 		}
 	}
@@ -754,7 +934,7 @@ s16 Map::Get_Curr_House_Durability()
 	 Accessor fuction to refer grid
 */
 /**************************************************************************/
-Tiles** Map::Get_Refer_Grid()
+Tile_Grid Map::Get_Refer_Grid()
 {
 	return refer_grid;
 }
@@ -764,114 +944,1010 @@ Tiles** Map::Get_Refer_Grid()
 	 Accessor fuction to Display grid
 */
 /**************************************************************************/
-Tiles** Map::Get_Display_Grid()
+Tile_Grid Map::Get_Display_Grid()
 {
 	return display_grid;
 }
 
 /**************************************************************************/
 /*!
-	 function is called to give a time based behaviour update
+	 Swap the double buffer grid 
+*/
+/**************************************************************************/
+void Map::Swap_Grid()
+{
+	std::swap(refer_grid, display_grid);
+}
+
+/**************************************************************************/
+/*!
+	 this function runs the fire, earth and state behaviour of one tile in
+	 a single pass, the tile is read from both grids and written back once.
+	 It is queued for next tick if it changed or still holds fire, water or
+	 decaying earth
 */
 /**************************************************************************/
-bool Behaviour_Update() {
-	if (behaviour_timer <= 0)
+void Map::Update_Tile(s32 x_value, s32 y_value, bool fire_spread, Tile_Band& band)
+{
+	if (!band.stencil.Covers(x_value, y_value))
 	{
-		return true;
+		band.stencil.Sum_Row(y_value, x_value, std::min(x_value + STENCIL_RUN, x_size));
 	}
-	else
+	Tiles const refer{ refer_grid[y_value][x_value] };
+	Tiles& target{ display_grid[y_value][x_value] };
+	// Fields the rules leave alone carry over from the last tick, so a tile that
+	// settles holds the same value in both grids and the hash of display_grid
+	// covers everything the next tick reads
+	Tiles update{ refer };
+	s32 trees_burnt{ band.trees_burnt };
+	s32 house_damage{ band.house_damage };
+	Fire_Behaviour(refer, update, band.stencil.Get_Totals(x_value), fire_spread, house_durability != 0, band.trees_burnt, band.house_damage);
+	if (random_spread && fire_spread && refer.Get_Fire() <= 0 && update.Get_Fire() > 0 && !Spread_Roll(x_value, y_value))
+	{
+		update.Set_Fire(refer.Get_Fire());
+	}
+	Earth_Behaviour(refer, update);
+	State_Behaviour(update, house_durability == 0);
+	if (record_writes && update != target)
+	{
+		band.writes.push_back(Tile_Record{ &target, target });
+	}
+	target = update;
+
+	bool changed{ update != refer };
+	band.tiles_changed += changed;
+	if (changed)
+	{
+		// refer is the tile as the hash has it from the end of the last tick
+		band.tile_hash ^= Tile_Key_Hash(y_value * x_size + x_value, refer) ^ Tile_Key_Hash(y_value * x_size + x_value, update);
+		Emit_Tile_Events(refer, update, x_value, y_value, band.trees_burnt != trees_burnt, band);
+	}
+	if (band.house_damage != house_damage)
+	{
+		band.events.push_back(Map_Event{ HOUSE_DAMAGED, static_cast<s8>(band.house_damage - house_damage), x_value, y_value });
+	}
+	if (changed || update.Get_Fire() != 0 || (update.Get_Earth_Durability() > 0 && !update.Is_Earth_Permanant()))
+	{
+		band.frontier.push_back(y_value * x_size + x_value);
+	}
+	if (update.Get_Fire() > 0)
 	{
-		behaviour_timer -= delta_time;
-		return false;
+		band.burning.push_back(y_value * x_size + x_value);
 	}
 }
 
 /**************************************************************************/
 /*!
-	 function is called to give a time based fire spread update
+	 this function records what happened to a tile that changed this tick
+	 in its band's events
 */
 /**************************************************************************/
-bool Fire_Check()
+void Map::Emit_Tile_Events(Tiles const& refer, Tiles const& update, s32 x_value, s32 y_value, bool tree_burnt, Tile_Band& band)
 {
-	if (fire_timer <= 0) 
+	if (refer.Get_Fire() <= 0 && update.Get_Fire() > 0)
+	{
+		band.events.push_back(Map_Event{ IGNITED, update.Get_Fire(), x_value, y_value });
+	}
+	else if (refer.Get_Fire() > 0 && update.Get_Fire() <= 0)
+	{
+		band.events.push_back(Map_Event{ EXTINGUISHED, update.Get_Fire(), x_value, y_value });
+	}
+	if (tree_burnt)
 	{
-		return true;
+		band.events.push_back(Map_Event{ TREE_BURNT, 0, x_value, y_value });
 	}
-	else 
+	if (refer.Get_Earth_Durability() > 0 && update.Get_Earth_Durability() <= 0)
 	{
-		return false;
+		band.events.push_back(Map_Event{ EARTH_COLLAPSED, 0, x_value, y_value });
 	}
 }
 
 /**************************************************************************/
 /*!
-	 function is called to give a time based fire spread update
+	 this function wakes a tile and its neighbours for next tick, call it
+	 whenever a tile is changed outside of Tile_Behaviour
+*/
+/**************************************************************************/
+void Map::Mark_Active(s32 x_value, s32 y_value)
+{
+	frontier.push_back(y_value * x_size + x_value);
+}
+
+/**************************************************************************/
+/*!
+	 this function turns the frontier left by last tick into the sorted
+	 list of tiles to update this tick, every frontier tile plus its 3x3
+	 neighbours. A tile outside of it has the same neighbours as last tick
+	 and no fire around it, so updating it would not change it
 */
 /**************************************************************************/
-void Fire_Update()
+void Map::Build_Active_Tiles()
 {
-	if (fire_timer > 0) {
-		fire_timer -= delta_time;
+	active_tiles.clear();
+	for (s32 index : frontier)
+	{
+		s32 x_value{ index % x_size };
+		s32 y_value{ index / x_size };
+		for (s32 j{ std::max(y_value - 1, 0) }; j <= std::min(y_value + 1, y_size - 1); ++j)
+		{
+			for (s32 i{ std::max(x_value - 1, 0) }; i <= std::min(x_value + 1, x_size - 1); ++i)
+			{
+				s32 neighbour{ j * x_size + i };
+				if (!active_mark[neighbour])
+				{
+					active_mark[neighbour] = 1;
+					active_tiles.push_back(neighbour);
+				}
+			}
+		}
+	}
+	// Houses all turn to rubble once house durability has run out
+	if (house_durability == 0)
+	{
+		for (s32 index : house_tiles)
+		{
+			if (!active_mark[index])
+			{
+				active_mark[index] = 1;
+				active_tiles.push_back(index);
+			}
+		}
+	}
+	frontier.clear();
+	std::sort(active_tiles.begin(), active_tiles.end());
+	for (s32 index : active_tiles)
+	{
+		active_mark[index] = 0;
 	}
 }
 
 /**************************************************************************/
 /*!
-	 Swap the double buffer grid 
+	 Accessor function to the number of tiles updated last tick
 */
 /**************************************************************************/
-void Map::Swap_Grid()
+size_t Map::Get_Active_Count()
 {
-	Tiles** temp = refer_grid;
-	refer_grid = display_grid;
-	display_grid = temp;
+	return active_tiles.size();
 }
 
 /**************************************************************************/
 /*!
-	 This function updates all behaviour of Map object
+	 this function updates one band of the tiles of this tick. Bands split
+	 the rows of a full sweep, or the active tiles, into even parts
 */
 /**************************************************************************/
-void Map_Update()
+void Map::Update_Band(s32 band_index, s32 band_count, bool fire_spread)
 {
-	Fire_Update();
-	level_map.Wind_Behaviour();
-	if (Behaviour_Update())
+	Tile_Band& band = bands[band_index];
+	if (update_all)
 	{
-		level_map.Swap_Grid();
-		for (int i = 0; i < TILE_Y; i++)
+		s32 first_row{ y_size * band_index / band_count };
+		s32 last_row{ y_size * (band_index + 1) / band_count };
+		for (s32 i{ first_row }; i < last_row; i++)
 		{
-			for (int j = 0; j < TILE_X; j++)
+			band.stencil.Sum_Row(i, 0, x_size);
+			for (s32 j{}; j < x_size; j++)
 			{
-				level_map.Fire_Behaviour(static_cast<s8>(j), static_cast<s8>(i));
-				level_map.Earth_Behaviour(static_cast<s8>(j), static_cast<s8>(i));
-				level_map.State_Behaviour(static_cast<s8>(j), static_cast<s8>(i));
+				Update_Tile(j, i, fire_spread, band);
 			}
 		}
-		level_map.Player_Lose();
-
-		if (Fire_Check())
+	}
+	else
+	{
+		size_t first{ active_tiles.size() * band_index / band_count };
+		size_t last{ active_tiles.size() * (band_index + 1) / band_count };
+		for (size_t k{ first }; k < last; ++k)
 		{
-			fire_timer = level_map.Get_Fire_Time();
+			Update_Tile(active_tiles[k] % x_size, active_tiles[k] / x_size, fire_spread, band);
 		}
-		behaviour_timer = BEHAVIOUR_TIME;
 	}
-
 }
 
 /**************************************************************************/
 /*!
-	This function is called in Map to check for Player lose on behavior
-	update
+	 this function updates the tiles of the double buffer Tile grid that
+	 can change this tick, split into bands across the thread pool.
+	 Tiles only read refer_grid and the counters from the start of the
+	 tick, so the result is the same for any number of bands
 */
 /**************************************************************************/
-void Map::Player_Lose()
+void Map::Tile_Behaviour()
 {
-	std::pair<s8, s8> temp = {};
-	player.Get_Player_Tiles_Coordinates(temp.first, temp.second);
-	if(display_grid[temp.second][temp.first].fire > 0 || !display_grid[temp.second][temp.first].is_passable)
+	bool fire_spread{ fire_ticks_left <= 0 };
+	bool houses_destroyed{ house_durability == 0 };
+
+	if (update_all)
+	{
+		frontier.clear();
+		active_tiles.clear();
+	}
+	else
+	{
+		Build_Active_Tiles();
+	}
+
+	// Small jobs are not worth waking the workers for
+	size_t tiles{ update_all ? static_cast<size_t>(x_size) * static_cast<size_t>(y_size) : active_tiles.size() };
+	s32 band_count{ static_cast<s32>(std::min(tiles / MIN_BAND_TILES, static_cast<size_t>(thread_pool.Get_Thread_Count()))) };
+	band_count = std::max(band_count, 1);
+	if (update_all)
+	{
+		band_count = std::min(band_count, y_size);
+	}
+	bands.resize(static_cast<size_t>(band_count));
+	for (Tile_Band& band : bands)
+	{
+		if (band.stencil.width != x_size)
+		{
+			band.stencil.Resize(x_size);
+		}
+		band.stencil.Begin(refer_grid, wind_direction);
+		band.frontier.clear();
+		band.burning.clear();
+		band.events.clear();
+		band.writes.clear();
+		band.trees_burnt = 0;
+		band.house_damage = 0;
+		band.tiles_changed = 0;
+		band.tile_hash = 0;
+	}
+
+	thread_pool.Run(band_count, [this, band_count, fire_spread](s32 band_index) { Update_Band(band_index, band_count, fire_spread); });
+	update_all = false;
+
+	s32 house_damage{};
+	tiles_changed = 0;
+	// Every burning tile is on the frontier, so it was updated and is in a band
+	burning_tiles.clear();
+	for (Tile_Band& band : bands)
+	{
+		burning_tiles.insert(burning_tiles.end(), band.burning.begin(), band.burning.end());
+		frontier.insert(frontier.end(), band.frontier.begin(), band.frontier.end());
+		events.insert(events.end(), band.events.begin(), band.events.end());
+		for (Tile_Record const& write : band.writes)
+		{
+			Record_Write(write.tile, write.value);
+		}
+		tree_count -= band.trees_burnt;
+		house_damage += band.house_damage;
+		tiles_changed += band.tiles_changed;
+		tile_hash ^= band.tile_hash;
+	}
+	// Every tile that changed is on the frontier
+	for (s32 index : frontier)
+	{
+		tile_planes.Set_Tile(index % x_size, index / x_size, display_grid[index / x_size][index % x_size]);
+	}
+	house_durability = static_cast<s16>(std::max(house_durability - house_damage, 0));
+	if (!houses_destroyed && house_durability == 0)
+	{
+		events.push_back(Map_Event{ HOUSES_DESTROYED, 0, -1, -1 });
+	}
+
+	// Every house has been updated with no durability left, none are left standing
+	if (houses_destroyed)
 	{
-		Start_Music(defeat_music);
-		level_state = LS_DEFEAT;
+		if (recording_delta >= 0)
+		{
+			rewind_ring[recording_delta].house_tiles.swap(house_tiles);
+		}
+		house_tiles.clear();
 	}
-}
\ No newline at end of file
+}
+
+/**************************************************************************/
+/*!
+	 This function advances the fire, water, earth and wind simulation by
+	 one tick of BEHAVIOUR_TIME. Spells queued since the last tick are
+	 applied first. It makes no AlphaEngine calls, so it can run headless
+*/
+/**************************************************************************/
+void Map::Simulate_Tick()
+{
+	events.clear();
+	Begin_Tick_Delta();
+	Apply_Commands();
+	Swap_Grid();
+	bool full_sweep{ update_all };
+	Tile_Behaviour();
+
+	// Fire spreads on one tick out of every fire_spread_ticks
+	fire_ticks_left = fire_ticks_left <= 0 ? fire_spread_ticks - 1 : fire_ticks_left - 1;
+	spread_roll += SPREAD_ROLL_STEP;
+	Wind_Behaviour();
+	// Only the tiles this tick updated can have changed
+	if (track_fire_arrival)
+	{
+		fire_arrival.Update(display_grid, full_sweep ? nullptr : &active_tiles, Get_Fire_Conditions());
+#if defined(FIRE_ARRIVAL_CHECK)
+		// Checks the repair against growing the field from scratch, which costs the whole Map
+		_ASSERTE(Check_Fire_Arrival());
+#endif
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function runs tick_count ticks of the simulation back to back,
+	 without waiting on frame time
+*/
+/**************************************************************************/
+void Map::Run_Ticks(s32 tick_count)
+{
+	for (s32 i{}; i < tick_count; ++i)
+	{
+		Simulate_Tick();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function runs ticks back to back until the Map can no longer
+	 change, or max_ticks have run, and returns the number of ticks run.
+	 The Map is settled once a whole fire spread cycle goes by with no wind,
+	 no tile changing and no damage to the house, from then on every tick
+	 would repeat the same state
+*/
+/**************************************************************************/
+s32 Map::Run_Until_Quiescent(s32 max_ticks)
+{
+	s32 quiet_ticks{};
+	s32 ticks{};
+	while (ticks < max_ticks && quiet_ticks < fire_spread_ticks)
+	{
+		bool calm{ wind_direction == WIND::NO_WIND && !Has_Commands() };
+		s16 house_before{ house_durability };
+		Simulate_Tick();
+		++ticks;
+		quiet_ticks = (calm && tiles_changed == 0 && house_durability == house_before) ? quiet_ticks + 1 : 0;
+	}
+	return ticks;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of tiles changed by the last tick
+*/
+/**************************************************************************/
+s32 Map::Get_Tiles_Changed()
+{
+	return tiles_changed;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the events of the last tick. Tile events are in
+	 row major order, so they come out the same for any number of bands
+*/
+/**************************************************************************/
+std::vector<Map_Event> const& Map::Get_Events()
+{
+	return events;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the tiles burning after the last tick, as
+	 y * width + x in row major order. Fire cast since then shows up
+	 after the next tick
+*/
+/**************************************************************************/
+std::vector<s32> const& Map::Get_Burning_Tiles()
+{
+	return burning_tiles;
+}
+
+/**************************************************************************/
+/*!
+	 This function adds an event to the last tick's events, for the owner
+	 of the Map to report what the Map cannot see, like the player
+*/
+/**************************************************************************/
+void Map::Add_Event(u8 event, s32 x_value, s32 y_value, s8 value)
+{
+	events.push_back(Map_Event{ event, value, x_value, y_value });
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the width of the Map in tiles
+*/
+/**************************************************************************/
+s32 Map::Get_X_Size()
+{
+	return x_size;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the height of the Map in tiles
+*/
+/**************************************************************************/
+s32 Map::Get_Y_Size()
+{
+	return y_size;
+}
+
+/**************************************************************************/
+/*!
+	 This function saves the state of the Map and returns the id to restore
+	 it with. Nothing of the grids is copied now, tiles are recorded as
+	 they are first written afterwards. Each snapshot gets a new stamp, so
+	 the marks a slot kept from its last snapshot need no clearing
+*/
+/**************************************************************************/
+s32 Map::Take_Snapshot()
+{
+	s32 snapshot_id{};
+	while (snapshot_id < static_cast<s32>(snapshots.size()) && snapshots[snapshot_id].in_use)
+	{
+		++snapshot_id;
+	}
+	if (snapshot_id == static_cast<s32>(snapshots.size()))
+	{
+		snapshots.emplace_back();
+	}
+
+	if (++snapshot_stamp == 0)
+	{
+		// Stamps wrapped around, old marks could match the new ones
+		for (Map_Snapshot& slot : snapshots)
+		{
+			std::fill(slot.saved.begin(), slot.saved.end(), 0u);
+		}
+		snapshot_stamp = 1;
+	}
+
+	Map_Snapshot& snapshot = snapshots[snapshot_id];
+	snapshot.in_use = true;
+	snapshot.stamp = snapshot_stamp;
+	if (snapshot.saved.size() != grid_buffer_size * 2)
+	{
+		snapshot.saved.assign(grid_buffer_size * 2, 0);
+	}
+	snapshot.records.clear();
+	snapshot.display_first = display_grid.memory == first_buffer;
+	snapshot.frontier = frontier;
+	snapshot.burning_tiles = burning_tiles;
+	snapshot.house_tiles = house_tiles;
+	snapshot.events = events;
+	snapshot.update_all = update_all;
+	snapshot.tree_count = tree_count;
+	snapshot.wind_direction = wind_direction;
+	snapshot.map_weather = map_weather;
+	snapshot.wind_timer = wind_timer;
+	snapshot.house_durability = house_durability;
+	snapshot.fire_spread_ticks = fire_spread_ticks;
+	snapshot.fire_ticks_left = fire_ticks_left;
+	snapshot.tiles_changed = tiles_changed;
+	snapshot.spread_roll = spread_roll;
+	snapshot.tile_hash = tile_hash;
+	snapshot.tile_planes = tile_planes;
+	++snapshots_held;
+	record_writes = true;
+	return snapshot_id;
+}
+
+/**************************************************************************/
+/*!
+	 This function puts the Map back to the state it was in when the
+	 snapshot was taken, writing back only the tiles recorded since. The
+	 snapshot can be restored again later. Queued spells are dropped
+*/
+/**************************************************************************/
+void Map::Restore_Snapshot(s32 snapshot_id)
+{
+	if (snapshot_id < 0 || snapshot_id >= static_cast<s32>(snapshots.size()) || !snapshots[snapshot_id].in_use)
+		return;
+
+	Map_Snapshot& snapshot = snapshots[snapshot_id];
+	// Other snapshots keep the tiles about to be overwritten
+	for (Tile_Record const& record : snapshot.records)
+	{
+		Record_Write(record.tile, *record.tile);
+	}
+	for (Tile_Record const& record : snapshot.records)
+	{
+		*record.tile = record.value;
+	}
+	if ((display_grid.memory == first_buffer) != snapshot.display_first)
+	{
+		Swap_Grid();
+	}
+
+	frontier = snapshot.frontier;
+	burning_tiles = snapshot.burning_tiles;
+	house_tiles = snapshot.house_tiles;
+	events = snapshot.events;
+	update_all = snapshot.update_all;
+	tree_count = snapshot.tree_count;
+	wind_direction = snapshot.wind_direction;
+	map_weather = snapshot.map_weather;
+	wind_timer = snapshot.wind_timer;
+	house_durability = snapshot.house_durability;
+	fire_spread_ticks = snapshot.fire_spread_ticks;
+	fire_ticks_left = snapshot.fire_ticks_left;
+	tiles_changed = snapshot.tiles_changed;
+	spread_roll = snapshot.spread_roll;
+	tile_hash = snapshot.tile_hash;
+	tile_planes = snapshot.tile_planes;
+	{
+		std::lock_guard<std::mutex> lock{ command_mutex };
+		queued_commands.clear();
+		++state_version;
+	}
+	// The ticks kept led to the state left behind, not this one
+	Clear_Rewind();
+	Rebuild_Fire_Arrival();
+}
+
+/**************************************************************************/
+/*!
+	 This function frees a snapshot, once none are held tile writes are no
+	 longer recorded
+*/
+/**************************************************************************/
+void Map::Release_Snapshot(s32 snapshot_id)
+{
+	if (snapshot_id < 0 || snapshot_id >= static_cast<s32>(snapshots.size()) || !snapshots[snapshot_id].in_use)
+		return;
+
+	Map_Snapshot& snapshot = snapshots[snapshot_id];
+	snapshot.in_use = false;
+	snapshot.records.clear();
+	--snapshots_held;
+	record_writes = snapshots_held > 0 || !rewind_ring.empty();
+}
+
+/**************************************************************************/
+/*!
+	 This function records the value a grid tile had before it is written,
+	 in every snapshot that has not recorded that tile yet and in the tick
+	 being recorded for rewinding
+*/
+/**************************************************************************/
+void Map::Record_Write(Tiles* tile, Tiles old_value)
+{
+	if (!record_writes)
+		return;
+
+	u32 key{ Tile_Key(tile) };
+	for (Map_Snapshot& snapshot : snapshots)
+	{
+		if (snapshot.in_use && snapshot.saved[key] != snapshot.stamp)
+		{
+			snapshot.saved[key] = snapshot.stamp;
+			snapshot.records.push_back(Tile_Record{ tile, old_value });
+		}
+	}
+	if (recording_delta >= 0)
+	{
+		rewind_ring[recording_delta].tiles.push_back(Tile_Delta{ key, old_value });
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the index of a grid tile in the two grid
+	 buffers, tiles of the first buffer come first. The index of a tile does
+	 not change when the grids are swapped
+*/
+/**************************************************************************/
+u32 Map::Tile_Key(Tiles const* tile)
+{
+	// Tiles of both grids are told apart by which allocation they are in
+	uintptr_t address{ reinterpret_cast<uintptr_t>(tile) };
+	uintptr_t first{ reinterpret_cast<uintptr_t>(first_buffer) };
+	if (address >= first && address < first + grid_buffer_size * sizeof(Tiles))
+	{
+		return static_cast<u32>((address - first) / sizeof(Tiles));
+	}
+	Tiles* second{ display_grid.memory == first_buffer ? refer_grid.memory : display_grid.memory };
+	return static_cast<u32>(grid_buffer_size + (address - reinterpret_cast<uintptr_t>(second)) / sizeof(Tiles));
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the grid tile at an index given by Tile_Key
+*/
+/**************************************************************************/
+Tiles* Map::Key_Tile(u32 key)
+{
+	if (key < grid_buffer_size)
+		return first_buffer + key;
+	Tiles* second{ display_grid.memory == first_buffer ? refer_grid.memory : display_grid.memory };
+	return second + (key - grid_buffer_size);
+}
+
+/**************************************************************************/
+/*!
+	 This function sets how many of the last ticks are kept to be undone
+	 by Rewind, 0 stops recording them. The ticks kept so far are dropped
+*/
+/**************************************************************************/
+void Map::Set_Rewind_Capacity(s32 tick_count)
+{
+	rewind_ring.assign(static_cast<size_t>(std::max(tick_count, 0)), Tick_Delta{});
+	Clear_Rewind();
+	record_writes = snapshots_held > 0 || !rewind_ring.empty();
+}
+
+/**************************************************************************/
+/*!
+	 This function starts recording a tick into the rewind ring, over the
+	 oldest tick once the ring is full. Tile writes go to this tick until
+	 the next one begins
+*/
+/**************************************************************************/
+void Map::Begin_Tick_Delta()
+{
+	if (rewind_ring.empty())
+		return;
+
+	Tick_Delta& delta = rewind_ring[rewind_head];
+	delta.tiles.clear();
+	delta.house_tiles.clear();
+	delta.display_first = display_grid.memory == first_buffer;
+	delta.update_all = update_all;
+	delta.tree_count = tree_count;
+	delta.wind_direction = wind_direction;
+	delta.wind_timer = wind_timer;
+	delta.house_durability = house_durability;
+	delta.fire_ticks_left = fire_ticks_left;
+	delta.tiles_changed = tiles_changed;
+	delta.spread_roll = spread_roll;
+	delta.tile_hash = tile_hash;
+
+	recording_delta = rewind_head;
+	rewind_head = (rewind_head + 1) % static_cast<s32>(rewind_ring.size());
+	rewind_count = std::min(rewind_count + 1, static_cast<s32>(rewind_ring.size()));
+}
+
+/**************************************************************************/
+/*!
+	 This function undoes up to tick_count of the last ticks, newest first,
+	 and returns how many were undone. Only the tiles those ticks wrote are
+	 touched, the next tick then updates every tile once like after Map_Init
+*/
+/**************************************************************************/
+s32 Map::Rewind(s32 tick_count)
+{
+	s32 ticks{ std::min(tick_count, rewind_count) };
+	if (ticks <= 0)
+		return 0;
+
+	recording_delta = -1;
+	s32 const ring_size{ static_cast<s32>(rewind_ring.size()) };
+	for (s32 i{}; i < ticks; ++i)
+	{
+		rewind_head = (rewind_head + ring_size - 1) % ring_size;
+		Tick_Delta& delta = rewind_ring[rewind_head];
+		// Tiles written more than once in the tick are undone back to their first value
+		for (auto record = delta.tiles.rbegin(); record != delta.tiles.rend(); ++record)
+		{
+			Tiles* tile{ Key_Tile(record->key) };
+			Record_Write(tile, *tile);
+			*tile = record->value;
+		}
+		if ((display_grid.memory == first_buffer) != delta.display_first)
+		{
+			Swap_Grid();
+		}
+		if (!delta.house_tiles.empty())
+		{
+			house_tiles.swap(delta.house_tiles);
+		}
+		update_all = delta.update_all;
+		tree_count = delta.tree_count;
+		wind_direction = delta.wind_direction;
+		wind_timer = delta.wind_timer;
+		house_durability = delta.house_durability;
+		fire_ticks_left = delta.fire_ticks_left;
+		tiles_changed = delta.tiles_changed;
+		spread_roll = delta.spread_roll;
+		tile_hash = delta.tile_hash;
+		delta.tiles.clear();
+		--rewind_count;
+	}
+	// Writes before the next tick belong to the tick before it
+	recording_delta = rewind_count > 0 ? (rewind_head + ring_size - 1) % ring_size : -1;
+
+	frontier.clear();
+	events.clear();
+	update_all = true;
+	Rebuild_Burning_Tiles();
+	tile_planes.Rebuild(display_grid);
+	{
+		std::lock_guard<std::mutex> lock{ command_mutex };
+		queued_commands.clear();
+		++state_version;
+	}
+	Rebuild_Fire_Arrival();
+	return ticks;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of ticks Rewind can undo
+*/
+/**************************************************************************/
+s32 Map::Get_Rewind_Ticks()
+{
+	return rewind_count;
+}
+
+/**************************************************************************/
+/*!
+	 This function drops every tick kept in the rewind ring
+*/
+/**************************************************************************/
+void Map::Clear_Rewind()
+{
+	rewind_head = 0;
+	rewind_count = 0;
+	recording_delta = -1;
+}
+
+/**************************************************************************/
+/*!
+	 This function finds every burning tile of the display grid again
+*/
+/**************************************************************************/
+void Map::Rebuild_Burning_Tiles()
+{
+	burning_tiles.clear();
+	for (s32 i{}; i < y_size; ++i)
+	{
+		for (s32 j{}; j < x_size; ++j)
+		{
+			if (display_grid[i][j].Get_Fire() > 0)
+			{
+				burning_tiles.push_back(i * x_size + j);
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function turns the fire arrival field on or off. It costs a few
+	 bytes a tile and the tiles each tick updates, so it is only kept
+	 while something reads it
+*/
+/**************************************************************************/
+void Map::Track_Fire_Arrival(bool enabled)
+{
+	track_fire_arrival = enabled;
+	if (!enabled)
+	{
+		fire_arrival = Fire_Arrival{};
+		return;
+	}
+	fire_arrival.Resize(x_size, y_size);
+	Rebuild_Fire_Arrival();
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the wind, weather and houses the fire arrival
+	 field is grown under. The wind blows for as many more ticks as
+	 Wind_Behaviour will count its timer down before it stops
+*/
+/**************************************************************************/
+Fire_Conditions Map::Get_Fire_Conditions()
+{
+	Fire_Conditions conditions{};
+	conditions.wind_direction = wind_direction;
+	if (wind_direction != WIND::NO_WIND && BEHAVIOUR_TIME > 0)
+	{
+		f64 timer{ wind_timer };
+		do
+		{
+			++conditions.wind_ticks;
+			timer -= BEHAVIOUR_TIME;
+		} while (timer > 0);
+	}
+	conditions.spread_ticks = fire_spread_ticks;
+	conditions.ticks_to_spread = fire_ticks_left;
+	conditions.houses_standing = house_durability > 0;
+	return conditions;
+}
+
+/**************************************************************************/
+/*!
+	 This function grows the fire arrival field again from the burning
+	 tiles, after the Map jumped to a state the field was not grown for
+*/
+/**************************************************************************/
+void Map::Rebuild_Fire_Arrival()
+{
+	if (track_fire_arrival && display_grid.memory != nullptr)
+	{
+		fire_arrival.Rebuild(display_grid, Get_Fire_Conditions());
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function grows a fire arrival field from scratch and returns
+	 true if the field repaired every tick matches it on every tile
+*/
+/**************************************************************************/
+bool Map::Check_Fire_Arrival()
+{
+	Fire_Arrival full{};
+	full.Resize(x_size, y_size);
+	full.Rebuild(display_grid, Get_Fire_Conditions());
+	for (s32 y{}; y < y_size; ++y)
+	{
+		for (s32 x{}; x < x_size; ++x)
+		{
+			if (fire_arrival.Get_Ticks(x, y) != full.Get_Ticks(x, y))
+				return false;
+		}
+	}
+	return true;
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the ticks until fire is expected to reach a
+	 tile, 0 if it is burning and -1 if it is not expected to reach it or
+	 the field is not tracked
+*/
+/**************************************************************************/
+s32 Map::Get_Fire_Arrival(s32 x_value, s32 y_value)
+{
+	return fire_arrival.Get_Ticks(x_value, y_value);
+}
+
+/**************************************************************************/
+/*!
+	 This function makes this Map a copy of source as it is now, spells
+	 still queued included, to simulate ahead of it without touching it.
+	 The grids are only allocated again if the size differs, so a Map
+	 cloned over and over reuses them. The clone starts with no snapshots
+	 or rewind ticks of its own
+*/
+/**************************************************************************/
+void Map::Clone_From(Map& source)
+{
+	if (source.display_grid.memory == nullptr)
+		return;
+	if (display_grid.memory == nullptr || x_size != source.x_size || y_size != source.y_size)
+	{
+		Map_Unload();
+		Map_Load(source.x_size, source.y_size);
+	}
+	snapshots.clear();
+	snapshots_held = 0;
+	first_buffer = display_grid.memory;
+	Clear_Rewind();
+	record_writes = !rewind_ring.empty();
+
+	std::copy_n(source.display_grid.memory, grid_buffer_size, display_grid.memory);
+	std::copy_n(source.refer_grid.memory, grid_buffer_size, refer_grid.memory);
+	std::copy_n(source.init_grid.memory, grid_buffer_size, init_grid.memory);
+	std::copy_n(source.state_table, STATE_TABLE_SIZE, state_table);
+	earth_threshold[0] = source.earth_threshold[0];
+	earth_threshold[1] = source.earth_threshold[1];
+	max_wind_time = source.max_wind_time;
+	max_earth_durability = source.max_earth_durability;
+	max_wood_durability = source.max_wood_durability;
+	max_house_durability = source.max_house_durability;
+
+	frontier = source.frontier;
+	burning_tiles = source.burning_tiles;
+	house_tiles = source.house_tiles;
+	events.clear();
+	update_all = source.update_all;
+	tree_count = source.tree_count;
+	wind_direction = source.wind_direction;
+	map_weather = source.map_weather;
+	wind_timer = source.wind_timer;
+	house_durability = source.house_durability;
+	fire_spread_ticks = source.fire_spread_ticks;
+	fire_ticks_left = source.fire_ticks_left;
+	tiles_changed = source.tiles_changed;
+	random_spread = source.random_spread;
+	spread_threshold = source.spread_threshold;
+	spread_roll = source.spread_roll;
+	tile_hash = source.tile_hash;
+	tile_planes = source.tile_planes;
+	{
+		std::lock_guard<std::mutex> lock{ source.command_mutex };
+		applying_commands = source.queued_commands;
+	}
+	{
+		std::lock_guard<std::mutex> lock{ command_mutex };
+		queued_commands.swap(applying_commands);
+		++state_version;
+	}
+	applying_commands.clear();
+	if (track_fire_arrival)
+	{
+		fire_arrival.Resize(x_size, y_size);
+		Rebuild_Fire_Arrival();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to a number that changes whenever a tick runs, a
+	 spell is queued or the Map jumps to another state, to tell if work
+	 done on the Map's state is out of date
+*/
+/**************************************************************************/
+u32 Map::Get_State_Version()
+{
+	std::lock_guard<std::mutex> lock{ command_mutex };
+	return state_version;
+}
+
+/**************************************************************************/
+/*!
+	 This function hashes every tile of the Map again, the hash is only
+	 rebuilt when the whole grid is reset and is kept up to date by every
+	 tile write after that
+*/
+/**************************************************************************/
+void Map::Rebuild_Tile_Hash()
+{
+	tile_hash = 0;
+	if (display_grid.memory == nullptr)
+		return;
+	for (s32 i{}; i < y_size; ++i)
+	{
+		for (s32 j{}; j < x_size; ++j)
+		{
+			tile_hash ^= Tile_Key_Hash(i * x_size + j, display_grid[i][j]);
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the Zobrist hash of the state of the Map: every
+	 tile, the wind with the ticks it has left and the counters the next
+	 tick reads. Two Maps of the same level with the same hash play out the
+	 same, so states can be compared without comparing the grids. Spells
+	 still queued are not in it
+*/
+/**************************************************************************/
+u64 Map::Get_State_Hash()
+{
+	// Wind that has stopped leaves a timer behind that no longer matters
+	s32 wind_ticks{ wind_direction == WIND::NO_WIND ? 0 : static_cast<s32>(std::ceil(wind_timer / BEHAVIOUR_TIME)) };
+	u64 hash{ tile_hash };
+	hash ^= Zobrist_Key(WIND_SLOT, static_cast<u64>(wind_direction) | static_cast<u64>(static_cast<u32>(wind_ticks)) << 8);
+	hash ^= Zobrist_Key(COUNTER_SLOT, static_cast<u64>(static_cast<u16>(house_durability)) | static_cast<u64>(static_cast<u32>(tree_count)) << 16
+		| static_cast<u64>(static_cast<u8>(fire_ticks_left)) << 48);
+	if (random_spread)
+	{
+		hash ^= Zobrist_Key(SPREAD_SLOT, spread_roll);
+	}
+	return hash;
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the Zobrist key of something standing on a tile,
+	 to hash what moves over the Map along with the Map's own state
+*/
+/**************************************************************************/
+u64 Map::Get_Position_Key(s32 x_value, s32 y_value)
+{
+	return Zobrist_Key(POSITION_SLOT, static_cast<u64>(static_cast<u32>(y_value)) << 32 | static_cast<u32>(x_value));
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the plane of a Tile_Planes::PLANE, one bit for
+	 every tile of the Map as it is now
+*/
+/**************************************************************************/
+Bit_Plane const& Map::Get_Plane(u8 plane)
+{
+	return tile_planes.planes[plane];
+}
@@ -16,8 +16,20 @@
 				Dynamically allocates Tiles array for Map of Forest Force
 			-Map_Init
 				Initialises the double buffer Tiles arrays and other Map related objects
-			-Map_Update
+			-Simulate_Tick
 				Updates an alternating double buffers with game logic
+			-Run_Ticks / Run_Until_Quiescent
+				Runs the simulation headless, as fast as the CPU allows
+			-Rewind
+				Steps the simulation back through the ticks kept in the rewind ring
+			-Get_Fire_Arrival
+				Ticks until fire is expected on a tile, kept up to date every tick
+			-Clone_From
+				Copies the simulation state of another Map, reusing the grids
+			-Get_State_Hash
+				Zobrist hash of the Map's state, kept up to date by every tile write
+			-Get_Plane
+				Bit planes of the burning, wet, passable and near fire tiles
 			-Map_Unload
 				Frees Tiles array for Map of Forest Force
 Copyright (C) 2024 DigiPen Institute of Technology.
@@ -27,6 +39,10 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 /******************************************************************************/
 #pragma once
 #include "pch.hpp"
+#include "Fire_Stencil.hpp"
+#include "Fire_Arrival.hpp"
+#include "Tile_Planes.hpp"
+#include <mutex>						// Guards the spell command queue
 
 extern s8 WATER_STRENGTH_MULTIPLER;
 extern f64 BEHAVIOUR_TIME;
@@ -55,28 +71,209 @@ struct Tile_Asset
 	void Tile_Asset_Unload();
 
 };
+// A single tile packed into 32 bits so that more of the grid fits in cache.
+//	bits  0-4	fire (signed, water is negative)
+//	bits  5-12	wood durability
+//	bits 13-20	earth durability
+//	bits 21-23	terrain type
+//	bits 24-25	tile type
+//	bit  26		is passable
+//	bit  27		is near fire
+//	bit  28		is earth permanant
 struct Tiles
 {
-	s8  fire{}, wood_durability{}, earth_durability{};
-	u8 terrain_type{}, tile_type{};
-	bool is_passable{}, is_near_fire{}, is_earth_permanant{};
+	s8 Get_Fire() const { return static_cast<s8>((static_cast<s32>(Get_Bits(FIRE_SHIFT, FIRE_MASK)) ^ FIRE_SIGN) - FIRE_SIGN); }
+	s8 Get_Wood_Durability() const { return static_cast<s8>(Get_Bits(WOOD_SHIFT, DURABILITY_MASK)); }
+	s8 Get_Earth_Durability() const { return static_cast<s8>(Get_Bits(EARTH_SHIFT, DURABILITY_MASK)); }
+	u8 Get_Terrain_Type() const { return static_cast<u8>(Get_Bits(TERRAIN_SHIFT, TERRAIN_MASK)); }
+	u8 Get_Tile_Type() const { return static_cast<u8>(Get_Bits(TYPE_SHIFT, TYPE_MASK)); }
+	bool Is_Passable() const { return Get_Bits(PASSABLE_SHIFT, 1u) != 0; }
+	bool Is_Near_Fire() const { return Get_Bits(NEAR_FIRE_SHIFT, 1u) != 0; }
+	bool Is_Earth_Permanant() const { return Get_Bits(PERMANANT_SHIFT, 1u) != 0; }
+
+	void Set_Fire(s8 value) { Set_Bits(FIRE_SHIFT, FIRE_MASK, static_cast<u32>(value)); }
+	void Set_Wood_Durability(s8 value) { Set_Bits(WOOD_SHIFT, DURABILITY_MASK, static_cast<u32>(value)); }
+	void Set_Earth_Durability(s8 value) { Set_Bits(EARTH_SHIFT, DURABILITY_MASK, static_cast<u32>(value)); }
+	void Set_Terrain_Type(u8 value) { Set_Bits(TERRAIN_SHIFT, TERRAIN_MASK, value); }
+	void Set_Tile_Type(u8 value) { Set_Bits(TYPE_SHIFT, TYPE_MASK, value); }
+	void Set_Passable(bool value) { Set_Bits(PASSABLE_SHIFT, 1u, value); }
+	void Set_Near_Fire(bool value) { Set_Bits(NEAR_FIRE_SHIFT, 1u, value); }
+	void Set_Earth_Permanant(bool value) { Set_Bits(PERMANANT_SHIFT, 1u, value); }
+
+	bool operator==(Tiles const& rhs) const { return bits == rhs.bits; }
+	bool operator!=(Tiles const& rhs) const { return bits != rhs.bits; }
+	u32 Get_Packed() const { return bits; }
+
+	// Bit layout, for code that works on whole rows of packed tiles at once
+	enum : u32 {
+		FIRE_SHIFT = 0, WOOD_SHIFT = 5, EARTH_SHIFT = 13, TERRAIN_SHIFT = 21, TYPE_SHIFT = 24,
+		PASSABLE_SHIFT = 26, NEAR_FIRE_SHIFT = 27, PERMANANT_SHIFT = 28,
+		FIRE_BITS = 5, FIRE_MASK = 0x1F, FIRE_SIGN = 0x10, DURABILITY_MASK = 0xFF, TERRAIN_MASK = 0x7, TYPE_MASK = 0x3
+	};
+
+private:
+	u32 bits{};
+
+	u32 Get_Bits(u32 shift, u32 mask) const { return (bits >> shift) & mask; }
+	void Set_Bits(u32 shift, u32 mask, u32 value) { bits = (bits & ~(mask << shift)) | ((value & mask) << shift); }
+};
+static_assert(sizeof(Tiles) == sizeof(u32), "Tiles must stay packed into 32 bits");
+
+// View into one contiguous Tiles buffer. Every row is stride tiles long and the
+// map is surrounded by a one tile halo, so grid[-1][x] and grid[y][x_size] are
+// valid reads that never contain fire or river.
+struct Tile_Grid
+{
+	Tiles* memory{ nullptr };	// Start of the aligned allocation (for freeing)
+	Tiles* origin{ nullptr };	// Tile (0,0) inside the halo
+	s32 stride{};				// Tiles per row, including halo and padding
+
+	Tiles* operator[](s32 y_value) const
+	{
+		return origin + static_cast<ptrdiff_t>(y_value) * stride;
+	}
+};
+
+// Something that happened during a tick, see Map::Get_Events
+struct Map_Event
+{
+	u8 event{};					// Map::EVENT
+	s8 value{};					// Fire of IGNITED and HOUSE_DAMAGED
+	s32 x{}, y{};				// Tile, -1 for events of the whole Map
+};
+
+// The value a grid tile held before it was first written after a snapshot
+struct Tile_Record
+{
+	Tiles* tile{ nullptr };
+	Tiles value{};
+};
+
+// One band of the tiles updated in a tick. Bands run on separate threads, so
+// each has its own stencil scratch, frontier, events and objective counters
+// that are merged into the Map in band order once the tick is done.
+struct Tile_Band
+{
+	Fire_Stencil stencil{};
+	std::vector<s32> frontier{};
+	std::vector<s32> burning{};
+	std::vector<Map_Event> events{};
+	std::vector<Tile_Record> writes{};	// Tiles changed while writes are recorded
+	s32 trees_burnt{};
+	s32 house_damage{};
+	s32 tiles_changed{};
+	u64 tile_hash{};					// Zobrist keys of the tiles the band changed
+};
+
+// A spell effect waiting to be applied at the start of the next tick
+struct Map_Command
+{
+	u8 command{};				// Map::COMMAND
+	s32 x{}, y{};
+	s8 value{};					// Fire value of SET_FIRE, direction of SET_WIND
+};
+
+// The state of a Map at one point in time. The grids are copy-on-write, a
+// snapshot only records the tiles written since it was taken, so taking and
+// restoring one costs the tiles that changed instead of the whole Map.
+struct Map_Snapshot
+{
+	bool in_use{};
+	u32 stamp{};							// Marks the tiles in records in saved, new for every snapshot taken
+	std::vector<u32> saved{};				// Tiles of both grids, kept between snapshots taken in this slot
+	std::vector<Tile_Record> records{};
+	bool display_first{};					// display_grid was the first grid buffer
+	std::vector<s32> frontier{};
+	std::vector<s32> burning_tiles{};
+	std::vector<s32> house_tiles{};
+	std::vector<Map_Event> events{};
+	bool update_all{};
+	s32 tree_count{};
+	u8 wind_direction{};
+	u8 map_weather{};
+	f64 wind_timer{};
+	s16 house_durability{};
+	s32 fire_spread_ticks{};
+	s32 fire_ticks_left{};
+	s32 tiles_changed{};
+	u64 spread_roll{};
+	u64 tile_hash{};
+	Tile_Planes tile_planes{};
+};
+
+// A grid tile by its index in the two grid buffers, see Map::Tile_Key
+struct Tile_Delta
+{
+	u32 key{};
+	Tiles value{};
+};
+
+// What one tick changed, enough to undo it. Only the tiles written are kept,
+// in write order, along with the counters and timers from the start of the tick.
+struct Tick_Delta
+{
+	std::vector<Tile_Delta> tiles{};
+	std::vector<s32> house_tiles{};			// House tiles, if the houses were destroyed on this tick
+	bool display_first{};
+	bool update_all{};
+	s32 tree_count{};
+	u8 wind_direction{};
+	f64 wind_timer{};
+	s16 house_durability{};
+	s32 fire_ticks_left{};
+	s32 tiles_changed{};
+	u64 spread_roll{};
+	u64 tile_hash{};
 };
 
 class Map
 {
-	s8 x_size{};
-	s8 y_size{};
-	Tiles** refer_grid{ nullptr };
-	Tiles** display_grid{ nullptr };
-	Tiles** init_grid{ nullptr };
-	Tiles** initial_refer_grid{ nullptr };
-	Tiles** initial_display_grid{ nullptr };
-	s16 tree_count{};
+	s32 x_size{};
+	s32 y_size{};
+	Tile_Grid refer_grid{};
+	Tile_Grid display_grid{};
+	Tile_Grid init_grid{};
+	size_t grid_buffer_size{};
+	std::vector<Tile_Band> bands{};
+	std::vector<s32> frontier{};		// Tiles that changed or hold fire/water/decaying earth, woken with their neighbours next tick
+	std::vector<s32> active_tiles{};	// Tiles updated this tick in row major order
+	std::vector<u8> active_mark{};		// Set while a tile is in active_tiles
+	std::vector<s32> house_tiles{};		// Houses all change at once when house durability runs out
+	std::vector<s32> burning_tiles{};	// Tiles with fire after the last tick in row major order
+	bool update_all{ true };			// The first tick after Map_Init updates every tile
+	// Terrain (bits 0-2) and passability (bit 3) a tile ends a tick with, see Build_State_Table
+	static constexpr u32 STATE_TABLE_SIZE{ 3u << 8 };
+	u8 state_table[STATE_TABLE_SIZE]{};
+	s32 earth_threshold[2]{};			// Earth above this is a mountain, for decaying and permanant earth
+	s32 tree_count{};
 	u8 wind_direction{ WIND::NO_WIND };
 	u8 map_weather{};
 	f64 wind_timer{};
 	s16 house_durability{ 0 };
-	f64 fire_spread_time{};
+	s32 fire_spread_ticks{ 1 };		// Ticks between fire spreading, set by the weather
+	s32 fire_ticks_left{};
+	s32 tiles_changed{};				// Tiles the last tick changed
+	bool random_spread{};				// Fire only catches on a tile whose spread roll passes
+	u32 spread_threshold{};				// Spread rolls below this pass, the spread chance out of 2^32
+	u64 spread_roll{};					// Seed of this tick's spread rolls
+	u32 state_version{};				// Changes with every tick and spell, guarded by command_mutex
+	std::vector<Map_Command> queued_commands{};		// Filled by Queue_Command, guarded by command_mutex
+	std::vector<Map_Command> applying_commands{};	// Taken from queued_commands by the tick applying them
+	std::mutex command_mutex{};
+	std::vector<Map_Event> events{};	// Events of the last tick in row major order
+	std::vector<Map_Snapshot> snapshots{};
+	s32 snapshots_held{};				// Snapshots in use
+	u32 snapshot_stamp{};				// Stamp of the last snapshot taken
+	Tiles* first_buffer{ nullptr };		// Memory of one of the two grids, tells them apart in snapshots
+	std::vector<Tick_Delta> rewind_ring{};	// The last ticks run, oldest first from rewind_head - rewind_count
+	s32 rewind_head{};					// Slot of the next tick
+	s32 rewind_count{};					// Ticks that can be undone
+	s32 recording_delta{ -1 };			// Slot tile writes are recorded to, -1 for none
+	bool record_writes{};				// Tile writes are recorded, for snapshots or the rewind ring
+	Fire_Arrival fire_arrival{};
+	bool track_fire_arrival{};			// The fire arrival field is repaired every tick
+	u64 tile_hash{};					// Zobrist hash of the tiles of display_grid, see Get_State_Hash
+	Tile_Planes tile_planes{};			// Bit planes of display_grid, kept up to date by every tile write
 
 
 public:
@@ -97,37 +294,57 @@ public:
 	enum WEATHER :u8 {
 		CLOUDY = 0, CLEAR, SUNNY
 	};
+	enum COMMAND :u8 {
+		SET_FIRE = 0, SET_EARTH, SET_WIND
+	};
+	enum EVENT :u8 {
+		IGNITED = 0, EXTINGUISHED, TREE_BURNT, HOUSE_DAMAGED, HOUSES_DESTROYED, EARTH_COLLAPSED, PLAYER_ENDANGERED
+	};
+	// Added to the seed of the spread rolls every tick
+	static constexpr u64 SPREAD_ROLL_STEP{ 0xD1B54A32D192ED03ull };
 
-	Map(s8 x_value = 0, s8 y_value = 0);
+	Map(s32 x_value = 0, s32 y_value = 0);
 
 	void Map_Unload();
 
-	void Map_Load(s8 x_value, s8 y_value);
+	void Map_Load(s32 x_value, s32 y_value);
 
 	//This function is currently not being called anywhere,
 	//but will be done in the future when addition checks 
 	//for player_lose are implemented
-	s8 Get_Fire( s8 x_value,  s8 y_value);
+	s8 Get_Fire( s32 x_value, s32 y_value);
 
-	bool Get_Passable( s8 x_value,  s8 y_value);
+	bool Get_Passable( s32 x_value, s32 y_value);
 
-	Tiles* Get_Tile( s8 x_value,  s8 y_value);
+	Tiles* Get_Tile( s32 x_value, s32 y_value);
 
-	void Set_Fire( s8 x_value,  s8 y_value, s8 fire_value);
+	void Set_Fire( s32 x_value, s32 y_value, s8 fire_value);
 
 	f64 Get_Fire_Time();
 
-	void Set_Init_Fire( s8 x_value,  s8 y_value, s8 fire_value);
+	void Set_Init_Fire( s32 x_value, s32 y_value, s8 fire_value);
 
-	void Set_Earth( s8 x_value,  s8 y_value);
+	void Set_Earth( s32 x_value, s32 y_value);
 
 	void Set_Wind(u8 direction);
 
 	u8 Get_Wind();
 
+	void Set_Spread_Chance(f32 chance, u64 seed);
+
+	bool Spread_Roll(s32 x_value, s32 y_value);
+
+	bool Spread_Roll(u64 seed, s32 x_value, s32 y_value);
+
+	void Queue_Command(u8 command, s32 x_value, s32 y_value, s8 value);
+
+	void Apply_Commands();
+
+	bool Has_Commands();
+
 	void Map_Init();
 
-	void Tile_Init(s8 type,  s8 x_value,  s8 y_value, u8 terrain);
+	void Tile_Init(s8 type,  s32 x_value, s32 y_value, u8 terrain);
 
 	void Weather_Init(u8 weather);
 
@@ -137,29 +354,104 @@ public:
 
 	s16 Get_Curr_House_Durability();
 
-	s16 Wood_Count();
+	s32 Wood_Count();
 
-	void Fire_Behaviour( s8 x_value,  s8 y_value);
+	void Fire_Behaviour(Tiles const& refer, Tiles& update, Fire_Totals const& totals, bool fire_spread, bool houses_standing,
+		s32& trees_burnt, s32& house_damage);
 
-	void Earth_Behaviour( s8 x_value,  s8 y_value);
+	void Earth_Behaviour(Tiles const& refer, Tiles& update);
 
 	void Wind_Behaviour();
 
-	void State_Behaviour( s8 x_value,  s8 y_value);
+	void Build_State_Table();
+
+	void State_Behaviour(Tiles& update, bool houses_destroyed);
+
+	void Tile_Behaviour();
+
+	void Update_Tile( s32 x_value, s32 y_value, bool fire_spread, Tile_Band& band);
+
+	void Emit_Tile_Events(Tiles const& refer, Tiles const& update, s32 x_value, s32 y_value, bool tree_burnt, Tile_Band& band);
+
+	void Update_Band(s32 band_index, s32 band_count, bool fire_spread);
+
+	void Mark_Active( s32 x_value, s32 y_value);
+
+	void Build_Active_Tiles();
+
+	size_t Get_Active_Count();
+
+	bool Check_Fire_Arrival();
 
 	void Swap_Grid();
 
-	Tiles** Get_Refer_Grid();
+	void Simulate_Tick();
+
+	void Run_Ticks(s32 tick_count);
+
+	s32 Run_Until_Quiescent(s32 max_ticks);
+
+	s32 Get_Tiles_Changed();
+
+	std::vector<Map_Event> const& Get_Events();
+
+	std::vector<s32> const& Get_Burning_Tiles();
+
+	void Add_Event(u8 event, s32 x_value, s32 y_value, s8 value);
+
+	Tile_Grid Get_Refer_Grid();
+
+	Tile_Grid Get_Display_Grid();
+
+	s32 Get_X_Size();
+
+	s32 Get_Y_Size();
+
+	s32 Take_Snapshot();
+
+	void Restore_Snapshot(s32 snapshot_id);
+
+	void Release_Snapshot(s32 snapshot_id);
+
+	void Record_Write(Tiles* tile, Tiles old_value);
+
+	u32 Tile_Key(Tiles const* tile);
+
+	Tiles* Key_Tile(u32 key);
+
+	void Set_Rewind_Capacity(s32 tick_count);
+
+	void Begin_Tick_Delta();
+
+	s32 Rewind(s32 tick_count);
+
+	s32 Get_Rewind_Ticks();
+
+	void Clear_Rewind();
+
+	void Rebuild_Burning_Tiles();
+
+	void Track_Fire_Arrival(bool enabled);
+
+	Fire_Conditions Get_Fire_Conditions();
+
+	void Rebuild_Fire_Arrival();
+
+	s32 Get_Fire_Arrival(s32 x_value, s32 y_value);
+
+	void Clone_From(Map& source);
+
+	u32 Get_State_Version();
+
+	void Rebuild_Tile_Hash();
+
+	u64 Get_State_Hash();
 
-	Tiles** Get_Display_Grid();
+	u64 Get_Position_Key(s32 x_value, s32 y_value);
 
-	void Player_Lose();
+	Bit_Plane const& Get_Plane(u8 plane);
 };
-void Map_Update();
-bool Behaviour_Update();
-bool Fire_Check();
-void Fire_Update();
 
 
-extern Map level_map;
+extern Map& level_map;
 extern Tile_Asset map_asset;
\ No newline at end of file
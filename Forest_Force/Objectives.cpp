@@ -13,28 +13,31 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 */
 /******************************************************************************/
 #include "Objectives.hpp"
-#include "Map.hpp"
+#include "World.hpp"
 #include "Level.hpp"
-#include "Player.hpp"
 #include "Graphics.hpp"
 #include "User_Data.hpp"
 #include "Audio.hpp"
 
-Objectives objectives;
+/**************************************************************************/
+/*!
+	This function sets the World the objectives are checked in.
+*/
+/**************************************************************************/
+void Objectives::Set_World(World& owner) {
+	this->world = &owner;
+}
 
 /**************************************************************************/
 /*!
 	This function is called during the loading of a level file, where
-	memory will be allocated for each individual objective created. Also
-	loads the star texture used in the victory screen.
+	memory will be allocated for each individual objective created.
 */
 /**************************************************************************/
 void Objectives::Load(s8 obj1, std::string obj1_params,
 	s8 obj2, std::string obj2_params,
 	s8 obj3, std::string obj3_params){
 	this->objective = new u8[3];
-	empty_star_image = AEGfxTextureLoad("Assets/UI/Objectives/empty_star.png");
-	yellow_star_image = AEGfxTextureLoad("Assets/UI/Objectives/yellow_star.png");
 
 	// Objective 1 memory allocation / creation
 	{
@@ -112,6 +115,17 @@ void Objectives::Load(s8 obj1, std::string obj1_params,
 	}
 }
 
+/**************************************************************************/
+/*!
+	This function loads the star texture used in the victory screen. Only
+	the World being played needs it.
+*/
+/**************************************************************************/
+void Objectives::Load_Assets() {
+	empty_star_image = AEGfxTextureLoad("Assets/UI/Objectives/empty_star.png");
+	yellow_star_image = AEGfxTextureLoad("Assets/UI/Objectives/yellow_star.png");
+}
+
 /**************************************************************************/
 /*!
 	This function is called at the start of each level (even on restart)
@@ -152,17 +166,24 @@ void Objectives::Initialize() {
 */
 /**************************************************************************/
 void Objectives::Update() {
-	if (level_state == LS_PLAYING) {
+	if (this->world->state == LS_PLAYING) {
+		// Trees and houses only go on a tick that burnt a tree or destroyed the houses
+		bool tree_burnt{ false }, houses_destroyed{ false };
+		for (Map_Event const& event : this->world->Get_Events()) {
+			tree_burnt = tree_burnt || event.event == Map::TREE_BURNT;
+			houses_destroyed = houses_destroyed || event.event == Map::HOUSES_DESTROYED;
+		}
+
 		if (this->catch_arsonist != nullptr) {
 			if (!this->catch_arsonist->Completed()) {
-				std::pair<s8, s8> player_pos{};
-				player.Get_Player_Tiles_Coordinates(player_pos.first, player_pos.second);
-				std::pair<s8, s8> arsonist_pos = this->catch_arsonist->Get_Tiles_Coordinates();
+				std::pair<s32, s32> player_pos{};
+				this->world->player.Get_Player_Tiles_Coordinates(player_pos.first, player_pos.second);
+				std::pair<s32, s32> arsonist_pos = this->catch_arsonist->Get_Tiles_Coordinates();
 				if (player_pos.first == arsonist_pos.first && player_pos.second == arsonist_pos.second) {
 					this->catch_arsonist->Complete();
 					this->stars += 1;
 					Start_Music(victory_music);
-					level_state = LS_VICTORY;
+					this->world->state = LS_VICTORY;
 					Complete_Level(static_cast<int>(current - GS_LEVEL1 + 1), static_cast<int>(this->stars));
 				}
 			}
@@ -177,18 +198,18 @@ void Objectives::Update() {
 			}
 		}
 
-		if (this->tree_count != nullptr) {
+		if (this->tree_count != nullptr && tree_burnt) {
 			if (!this->tree_count->Failed()) {
-				if (this->tree_count->Update()) {
+				if (this->tree_count->Update(this->world->map)) {
 					this->tree_count->Fail();
 					this->stars -= 1;
 				}
 			}
 		}
 
-		if (this->save_house != nullptr) {
+		if (this->save_house != nullptr && houses_destroyed) {
 			if (!this->save_house->Failed()) {
-				if (this->save_house->Update()) {
+				if (this->save_house->Update(this->world->map)) {
 					this->save_house->Fail();
 					this->stars -= 1;
 				}
@@ -197,6 +218,95 @@ void Objectives::Update() {
 	}
 }
 
+/**************************************************************************/
+/*!
+	This function advances the time limit by the simulated time of a tick,
+	called by the World once per tick it runs.
+*/
+/**************************************************************************/
+void Objectives::Advance_Time(f64 seconds) {
+	if (this->time_limit != nullptr) {
+		this->time_limit->Advance(seconds);
+	}
+}
+
+/**************************************************************************/
+/*!
+	This function returns the progress of the objectives, to be put back
+	later by Restore_State.
+*/
+/**************************************************************************/
+Objectives_State Objectives::Save_State() const {
+	Objectives_State state{};
+	state.stars = this->stars;
+	if (this->catch_arsonist != nullptr) state.arsonist_caught = this->catch_arsonist->Completed();
+	if (this->time_limit != nullptr) {
+		state.time_counter = this->time_limit->GetTimeCounter();
+		state.time_failed = this->time_limit->Failed();
+	}
+	if (this->tree_count != nullptr) state.tree_failed = this->tree_count->Failed();
+	if (this->save_house != nullptr) state.house_failed = this->save_house->Failed();
+	return state;
+}
+
+/**************************************************************************/
+/*!
+	This function puts back the progress of the objectives saved by
+	Save_State.
+*/
+/**************************************************************************/
+void Objectives::Restore_State(Objectives_State const& state) {
+	this->stars = state.stars;
+	if (this->catch_arsonist != nullptr) {
+		this->catch_arsonist->Init();
+		if (state.arsonist_caught) this->catch_arsonist->Complete();
+	}
+	if (this->time_limit != nullptr) {
+		this->time_limit->Init();
+		this->time_limit->SetTimeCounter(state.time_counter);
+		if (state.time_failed) this->time_limit->Fail();
+	}
+	if (this->tree_count != nullptr) {
+		this->tree_count->Init();
+		if (state.tree_failed) this->tree_count->Fail();
+	}
+	if (this->save_house != nullptr) {
+		this->save_house->Init();
+		if (state.house_failed) this->save_house->Fail();
+	}
+}
+
+/**************************************************************************/
+/*!
+	This function returns what the loaded level asks of the player, so
+	its objectives can be checked headless.
+*/
+/**************************************************************************/
+Objectives_Goals Objectives::Get_Goals() const {
+	Objectives_Goals goals{};
+	if (this->objective != nullptr) {
+		for (int i{}; i < 3; ++i) {
+			if (this->objective[i] == Objectives::EMPTY) goals.empty += 1;
+		}
+	}
+	if (this->catch_arsonist != nullptr) {
+		goals.catch_arsonist = true;
+		std::pair<s32, s32> arsonist_pos = this->catch_arsonist->Get_Tiles_Coordinates();
+		goals.arsonist_x = arsonist_pos.first;
+		goals.arsonist_y = arsonist_pos.second;
+	}
+	if (this->time_limit != nullptr) {
+		goals.time_limit = true;
+		goals.time_limit_seconds = this->time_limit->GetTimeLimit();
+	}
+	if (this->tree_count != nullptr) {
+		goals.tree_count = true;
+		goals.trees_limit = this->tree_count->GetTreeLimit();
+	}
+	goals.save_house = this->save_house != nullptr;
+	return goals;
+}
+
 /**************************************************************************/
 /*!
 	This function unloads objective when exiting level game state. This is
@@ -209,12 +319,14 @@ void Objectives::Unload() {
 	delete this->time_limit;
 	delete this->tree_count;
 	delete this->save_house;
-	delete this->objective;
+	delete[] this->objective;
 	this->catch_arsonist = nullptr;
 	this->time_limit = nullptr;
 	this->tree_count = nullptr;
 	this->save_house = nullptr;
 	this->objective = nullptr;
-	AEGfxTextureUnload(empty_star_image);
-	AEGfxTextureUnload(yellow_star_image);
+	if (empty_star_image) AEGfxTextureUnload(empty_star_image);
+	if (yellow_star_image) AEGfxTextureUnload(yellow_star_image);
+	empty_star_image = nullptr;
+	yellow_star_image = nullptr;
 }
\ No newline at end of file
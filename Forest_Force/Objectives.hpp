@@ -16,23 +16,25 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "pch.hpp"
 #include "Map.hpp"
 
+class World;
+
 // Various different objective types.
 class Catch_Arsonist
 {
 private:
-	s8 x{}, y{};
+	s32 x{}, y{};
 	bool completed{ false };
 public:
 	Catch_Arsonist(std::string const& params) {
 		// String -> "23,15" means arsonist_x is 23, arsonist_y is 15
-		this->x = static_cast<s8>(std::stoi(params.substr(0, params.find_first_of(","))));
-		this->y = static_cast<s8>(std::stoi(params.substr(params.find_first_of(",") + 1, std::string::npos)));
+		this->x = static_cast<s32>(std::stoi(params.substr(0, params.find_first_of(","))));
+		this->y = static_cast<s32>(std::stoi(params.substr(params.find_first_of(",") + 1, std::string::npos)));
 	}
 	void Init() {
 		this->completed = false;
 	}
-	std::pair<s8, s8> Get_Tiles_Coordinates() {
-		std::pair<s8, s8> pos{ this->x,this->y };
+	std::pair<s32, s32> Get_Tiles_Coordinates() {
+		std::pair<s32, s32> pos{ this->x,this->y };
 		return pos;
 	}
 	void Complete() {
@@ -56,8 +58,11 @@ public:
 		this->time_counter = 0;
 		this->failed = false;
 	}
+	// Time only passes as the map ticks, so the limit keeps pace with the fire at any game speed
+	void Advance(f64 seconds) {
+		time_counter += seconds;
+	}
 	bool Update() {
-		time_counter += delta_time;
 		if (time_counter > time_limit) return true;
 		return false;
 	}
@@ -73,6 +78,9 @@ public:
 	f64 GetTimeCounter() const {
 		return this->time_counter;
 	}
+	void SetTimeCounter(f64 counter) {
+		this->time_counter = counter;
+	}
 };
 
 class Tree_Count
@@ -86,8 +94,8 @@ public:
 	void Init() {
 		this->failed = false;
 	}
-	bool Update() {
-		if (static_cast<s32>(level_map.Wood_Count()) < trees_limit) return true;
+	bool Update(Map& map) {
+		if (map.Wood_Count() < trees_limit) return true;
 		return false;
 	}
 	void Fail() {
@@ -104,20 +112,19 @@ public:
 class Save_House
 {
 private:
-	s8 x{}, y{};
+	s32 x{}, y{};
 	bool failed{ false };
 public:
 	Save_House(std::string const& params) {
 		// String -> "23,15" means house_x is 23, house_y is 15
-		this->x = static_cast<s8>(std::stoi(params.substr(0, params.find_first_of(","))));
-		this->y = static_cast<s8>(std::stoi(params.substr(params.find_first_of(",") + 1, std::string::npos)));
+		this->x = static_cast<s32>(std::stoi(params.substr(0, params.find_first_of(","))));
+		this->y = static_cast<s32>(std::stoi(params.substr(params.find_first_of(",") + 1, std::string::npos)));
 	}
 	void Init() {
 		this->failed = false;
 	}
-	bool Update() {
-		Tiles house = level_map.Get_Display_Grid()[y][x];
-		if (!level_map.Get_Curr_House_Durability()) return true;
+	bool Update(Map& map) {
+		if (!map.Get_Curr_House_Durability()) return true;
 		return false;
 	}
 	void Fail() {
@@ -128,6 +135,30 @@ public:
 	}
 };
 
+// Progress of the objectives, saved with a World snapshot
+struct Objectives_State
+{
+	u8 stars{};
+	bool arsonist_caught{ false };
+	f64 time_counter{};
+	bool time_failed{ false };
+	bool tree_failed{ false };
+	bool house_failed{ false };
+};
+
+// What a level asks of the player, for checking its objectives without playing it
+struct Objectives_Goals
+{
+	bool catch_arsonist{ false };
+	s32 arsonist_x{}, arsonist_y{};
+	bool time_limit{ false };
+	f64 time_limit_seconds{};
+	bool tree_count{ false };
+	s32 trees_limit{};
+	bool save_house{ false };
+	u8 empty{};			// EMPTY objectives, a star each
+};
+
 // Main Objective Class
 class Objectives
 {
@@ -140,15 +171,22 @@ private:
 	Time_Limit* time_limit{ nullptr };
 	Tree_Count* tree_count{ nullptr };
 	Save_House* save_house{ nullptr };
+	World* world{ nullptr };		// The World these objectives are checked in
 
 public:
 	enum : u8{
 		EMPTY = 0, CATCH_ARSONIST, TIME_LIMIT, TREE_COUNT, SAVE_HOUSE
 	};
 
+	void Set_World(World& owner);
 	void Load(s8 obj1, std::string obj1_params, s8 obj2, std::string obj2_params, s8 obj3, std::string obj3_params);
+	void Load_Assets();
 	void Initialize();
 	void Update();
+	void Advance_Time(f64 seconds);
+	Objectives_State Save_State() const;
+	void Restore_State(Objectives_State const& state);
+	Objectives_Goals Get_Goals() const;
 	void Unload();
 
 	friend void Draw_Paused_Objectives_UI(Objectives& objectives);					// For drawing Objectives UI (while paused)
@@ -156,4 +194,4 @@ public:
 	friend void Draw_Victory_Screen(Objectives& objectives);						// For displaying stars
 };
 
-extern Objectives objectives;
+extern Objectives& objectives;
@@ -13,29 +13,33 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 */
 /******************************************************************************/
 #include "Player.hpp"
-#include "Map.hpp"
+#include "World.hpp"
 #include "Level.hpp"
 #include "Graphics.hpp"
 #include "Graphics_Utils.hpp"
 #include "Audio.hpp"
 #include "Water_Particle_System.hpp"
 #include "Earth_Particle_System.hpp"
+#include "Replay.hpp"
 
-Player player;
+/**************************************************************************/
+/*!
+	This function sets the World the player moves and casts spells in.
+*/
+/**************************************************************************/
+void Player::Set_World(World& owner) {
+	this->world = &owner;
+}
 
 /**************************************************************************/
 /*!
-	This function sets the spawn location of the player and the textures
-	as well as the various const read from file.
+	This function sets the spawn location of the player as well as the
+	various const read from file.
 */
 /**************************************************************************/
-void Player::Load(s8 player_initial_x, s8 player_initial_y) {
+void Player::Load(s32 player_initial_x, s32 player_initial_y) {
 	this->intital_x = player_initial_x;
 	this->initial_y = player_initial_y;
-	this->sprite_texture = AEGfxTextureLoad("Assets/Unit/player.png");
-	this->water_spell_texture = AEGfxTextureLoad("Assets/UI/Spell/water_spell.png");
-	this->earth_spell_texture = AEGfxTextureLoad("Assets/UI/Spell/earth_spell.png");
-	this->air_spell_texture = AEGfxTextureLoad("Assets/UI/Spell/air_spell.png");
 
 	// Updating CONST
 	this->player_move_speed = PLAYER_BASE_MOVE_SPEED;
@@ -47,16 +51,33 @@ void Player::Load(s8 player_initial_x, s8 player_initial_y) {
 	this->air_spell_range = PLAYER_AIR_RANGE;
 }
 
+/**************************************************************************/
+/*!
+	This function loads the textures for the player (and its spells). Only
+	the World being played needs them.
+*/
+/**************************************************************************/
+void Player::Load_Assets() {
+	this->sprite_texture = AEGfxTextureLoad("Assets/Unit/player.png");
+	this->water_spell_texture = AEGfxTextureLoad("Assets/UI/Spell/water_spell.png");
+	this->earth_spell_texture = AEGfxTextureLoad("Assets/UI/Spell/earth_spell.png");
+	this->air_spell_texture = AEGfxTextureLoad("Assets/UI/Spell/air_spell.png");
+}
+
 /**************************************************************************/
 /*!
 	This function unloads the textures for the player (and its spells)
 */
 /**************************************************************************/
 void Player::Unload() {
-	AEGfxTextureUnload(this->sprite_texture);
-	AEGfxTextureUnload(this->water_spell_texture);
-	AEGfxTextureUnload(this->earth_spell_texture);
-	AEGfxTextureUnload(this->air_spell_texture);
+	if (this->sprite_texture) AEGfxTextureUnload(this->sprite_texture);
+	if (this->water_spell_texture) AEGfxTextureUnload(this->water_spell_texture);
+	if (this->earth_spell_texture) AEGfxTextureUnload(this->earth_spell_texture);
+	if (this->air_spell_texture) AEGfxTextureUnload(this->air_spell_texture);
+	this->sprite_texture = nullptr;
+	this->water_spell_texture = nullptr;
+	this->earth_spell_texture = nullptr;
+	this->air_spell_texture = nullptr;
 }
 
 /**************************************************************************/
@@ -75,7 +96,7 @@ void Player::Get_Player_World_Coordinates(f32& x_coord,  f32& y_coord)
 	This is an accessor for the player's tile coords
 */
 /**************************************************************************/
-void Player::Get_Player_Tiles_Coordinates(s8& x_coord,s8& y_coord) {
+void Player::Get_Player_Tiles_Coordinates(s32& x_coord, s32& y_coord) {
 	x_coord = this->x;
 	y_coord = this->y;
 }
@@ -98,6 +119,32 @@ void Player::Initialize() {
 	this->air_spell_cooldown = 0;
 }
 
+/**************************************************************************/
+/*!
+	This function puts the player back to a saved copy of it, the textures
+	and the World it is in are kept.
+*/
+/**************************************************************************/
+void Player::Restore(Player const& saved) {
+	this->intital_x = saved.intital_x;
+	this->initial_y = saved.initial_y;
+	this->x = saved.x;
+	this->y = saved.y;
+	this->facing = saved.facing;
+	this->selected_spell = saved.selected_spell;
+	this->player_move_speed = saved.player_move_speed;
+	this->player_move_cooldown = saved.player_move_cooldown;
+	this->water_cast_speed = saved.water_cast_speed;
+	this->earth_cast_speed = saved.earth_cast_speed;
+	this->air_cast_speed = saved.air_cast_speed;
+	this->water_spell_cooldown = saved.water_spell_cooldown;
+	this->earth_spell_cooldown = saved.earth_spell_cooldown;
+	this->air_spell_cooldown = saved.air_spell_cooldown;
+	this->water_spell_range = saved.water_spell_range;
+	this->earth_spell_range = saved.earth_spell_range;
+	this->air_spell_range = saved.air_spell_range;
+}
+
 /**************************************************************************/
 /*!
 	This function is called to change the spell. The boolean determines 
@@ -105,33 +152,44 @@ void Player::Initialize() {
 */
 /**************************************************************************/
 void Player::Change_Spell(bool forward) {
+	Select_Spell(forward);
 	if (forward) {
-		this->selected_spell = (this->selected_spell + 1) % TOTAL_SPELLS;
 		next_rotate = true;
 	}
 	else {
-		this->selected_spell = (TOTAL_SPELLS + this->selected_spell - 1) % TOTAL_SPELLS;
 		previous_rotate = true;
 	}
 	switch (this->selected_spell) {
 	case WATER:
 		// Water Spell
 		Play_Sound(swap_water);
-		this->selected_spell = WATER;
 		break;
 	case EARTH:
 		// Earth Spell
 		Play_Sound(swap_earth);
-		this->selected_spell = EARTH;
 		break;
 	case AIR:
 		// AIR Spell
 		Play_Sound(swap_air);
-		this->selected_spell = AIR;
 		break;
 	}
 }
 
+/**************************************************************************/
+/*!
+	This function selects the next or previous spell, without the sound
+	and UI of Change_Spell so it can be replayed headless.
+*/
+/**************************************************************************/
+void Player::Select_Spell(bool forward) {
+	if (forward) {
+		this->selected_spell = (this->selected_spell + 1) % TOTAL_SPELLS;
+	}
+	else {
+		this->selected_spell = (TOTAL_SPELLS + this->selected_spell - 1) % TOTAL_SPELLS;
+	}
+}
+
 /**************************************************************************/
 /*!
 	This function is called each frame to reduce cooldown and check if
@@ -172,7 +230,34 @@ bool Player::Castable() {
 	It also contains the behaviour for each spell cast.
 */
 /**************************************************************************/
-bool Player::Cast(s8 grid_x, s8 grid_y) {
+bool Player::Cast(s32 grid_x, s32 grid_y) {
+	if (!Cast_Spell(grid_x, grid_y)) {
+		return false;
+	}
+	switch (this->selected_spell) {
+	case WATER: // Water Spell
+		Water_Particles_Spawn(grid_x, grid_y);
+		Play_Sound(cast_water);
+		break;
+	case EARTH: // Earth Spell
+		Earth_Particles_Spawn(grid_x, grid_y);
+		Play_Sound(cast_earth);
+		break;
+	case AIR: // AIR Spell
+		Play_Sound(cast_air);
+		break;
+	}
+	return true;
+}
+
+/**************************************************************************/
+/*!
+	This function casts the selected spell if it is in range, without the
+	particles and sound of Cast so it can be replayed headless. Spell
+	effects are queued and land at the start of the next tick.
+*/
+/**************************************************************************/
+bool Player::Cast_Spell(s32 grid_x, s32 grid_y) {
 	bool out_of_range{ false };
 	switch (this->selected_spell) {
 	case WATER: // Water Spell
@@ -182,20 +267,16 @@ bool Player::Cast(s8 grid_x, s8 grid_y) {
 			return false;
 		}
 		// This function is incharge of setting both fire and water. Water is negative.
-		level_map.Set_Fire(static_cast<s64>(grid_x), static_cast<s64>(grid_y), -3);
-		Water_Particles_Spawn(grid_x, grid_y);
+		this->world->map.Queue_Command(Map::SET_FIRE, grid_x, grid_y, -3);
 		this->water_spell_cooldown = 1.0 / this->water_cast_speed;
-		Play_Sound(cast_water);
 		break;
 	case EARTH: // Earth Spell
 		out_of_range = (std::abs(this->x - grid_x) + std::abs(this->y - grid_y)) > this->earth_spell_range;
 		if (out_of_range) {
 			return false;
 		}
-		level_map.Set_Earth(static_cast<s64>(grid_x), static_cast<s64>(grid_y));
-		Earth_Particles_Spawn(grid_x, grid_y);
+		this->world->map.Queue_Command(Map::SET_EARTH, grid_x, grid_y, 0);
 		this->earth_spell_cooldown = 1.0 / this->earth_cast_speed;
-		Play_Sound(cast_earth);
 		break;
 	case AIR: // AIR Spell
 		out_of_range = (std::abs(this->x - grid_x) + std::abs(this->y - grid_y)) > this->air_spell_range;
@@ -203,25 +284,22 @@ bool Player::Cast(s8 grid_x, s8 grid_y) {
 			return false;
 		}
 
-		s8 i{ grid_x - this->x }; // i is x value. (-1 if left of player)
-		s8 j{ grid_y - this->y }; // j is y value. (-1 if down of player)
+		s32 i{ grid_x - this->x }; // i is x value. (-1 if left of player)
+		s32 j{ grid_y - this->y }; // j is y value. (-1 if down of player)
+		u8 direction{ Map::WIND::NO_WIND };
 		if(i)
 		{
-			if (i < 0)level_map.Set_Wind(Map::WIND::LEFT);
-			if (i > 0)level_map.Set_Wind(Map::WIND::RIGHT);
+			if (i < 0)direction = Map::WIND::LEFT;
+			if (i > 0)direction = Map::WIND::RIGHT;
 		}
 		else if (j)
 		{
-			if (j < 0)level_map.Set_Wind(Map::WIND::DOWN);
-			if (j > 0)level_map.Set_Wind(Map::WIND::UP);
-		}
-		else
-		{
-			level_map.Set_Wind(Map::WIND::NO_WIND);
+			if (j < 0)direction = Map::WIND::DOWN;
+			if (j > 0)direction = Map::WIND::UP;
 		}
+		this->world->map.Queue_Command(Map::SET_WIND, grid_x, grid_y, static_cast<s8>(direction));
 
 		this->air_spell_cooldown = 1.0 / this->air_cast_speed;
-		Play_Sound(cast_air);
 		break;
 	}
 	return true;
@@ -253,7 +331,7 @@ bool Player::Moveable() {
 */
 /**************************************************************************/
 bool Player::Move(u8 direction) {
-	s8 x_movement{}, y_movement{};
+	s32 x_movement{}, y_movement{};
 	switch (direction) {
 	case LEFT:
 		x_movement--;
@@ -273,25 +351,24 @@ bool Player::Move(u8 direction) {
 		break;
 	}
 
-	bool out_of_bounds = (static_cast<s64>(this->x)+ x_movement < 0) || (static_cast<s64>(this->x)+ x_movement >= TILE_X) || (static_cast<s64>(this->y) + y_movement < 0) || (static_cast<s64>(this->y) + y_movement >= TILE_Y);
+	Map& map = this->world->map;
+	bool out_of_bounds = (static_cast<s64>(this->x)+ x_movement < 0) || (static_cast<s64>(this->x)+ x_movement >= map.Get_X_Size()) || (static_cast<s64>(this->y) + y_movement < 0) || (static_cast<s64>(this->y) + y_movement >= map.Get_Y_Size());
 	bool tile_passable{false};
 
 	// Only run "tile_passable" check if not out_of_bounds
-	if (!out_of_bounds) tile_passable = (level_map.Get_Passable(static_cast<s64>(this->x) + x_movement, static_cast<s64>(this->y) + y_movement));
+	if (!out_of_bounds) tile_passable = (map.Get_Passable(this->x + x_movement, this->y + y_movement));
 	else return false;
 	
 	if (tile_passable) {	//BUGFIX: Check Player lose when walking into fire (level_map.tile)
-		player_moved = true;
 		this->x += x_movement;
 		this->y += y_movement;
 		// Check if player got die
-		if (level_map.Get_Fire(this->x, this->y) > 0) { 
-			Start_Music(defeat_music);
-			level_state = LS_DEFEAT;
+		if (map.Get_Fire(this->x, this->y) > 0) { 
+			this->world->state = LS_DEFEAT;
 		}
 
 		// Check if player walking on slower train
-		u8 walking_terrain = level_map.Get_Tile(this->x, this->y)->terrain_type;
+		u8 walking_terrain = map.Get_Tile(this->x, this->y)->Get_Terrain_Type();
 		if (walking_terrain == Map::TERRAIN::BUSH || walking_terrain == Map::TERRAIN::HILL) {
 			// Slower Move speed when bashing through jungle and climbing hills
 			this->player_move_speed /= 2;
@@ -311,39 +388,50 @@ bool Player::Move(u8 direction) {
 */
 /**************************************************************************/
 void Player_Input() {
+	// Every command that changes the player is recorded for replays, stamped with the tick it lands before
+	s32 tick{ game_world.Get_Ticks_Run() };
+
 	// Only Check Input if Player can move
 	if (player.Moveable()) {
+		s8 direction{ -1 };
 		if (AEInputCheckCurr(AEVK_W)) {
-			player.Move(Player::UP);
+			direction = Player::UP;
 		}
 		else if (AEInputCheckCurr(AEVK_A)) {
-			player.Move(Player::LEFT);
+			direction = Player::LEFT;
 		}
 		else if (AEInputCheckCurr(AEVK_S)) {
-			player.Move(Player::DOWN);
+			direction = Player::DOWN;
 		}
 		else if (AEInputCheckCurr(AEVK_D)) {
-			player.Move(Player::RIGHT);
+			direction = Player::RIGHT;
+		}
+		if (direction >= 0 && player.Move(static_cast<u8>(direction))) {
+			// Set here and not in Move, Worlds being searched move their players on other threads
+			player_moved = true;
+			game_replay.Record(tick, Replay::MOVE, 0, 0, direction);
 		}
 	}
 
 	// Only Check Input if Player can cast Spells
 	if (player.Castable()) {
 		if (AEInputCheckTriggered(AEVK_LBUTTON)) {
-			s8 grid_x{}, grid_y{};
+			s32 grid_x{}, grid_y{};
 			Get_Mouse_Tile_Coordinates(grid_x, grid_y);
 
-			if (grid_x != INVALID_TILE)
-				player.Cast(grid_x, grid_y);
+			if (grid_x != INVALID_TILE && player.Cast(grid_x, grid_y))
+				game_replay.Record(tick, Replay::CAST, grid_x, grid_y, 0);
 		}
 	}
 
 	// Checks for Switching Spells
 	if (AEInputCheckTriggered(AEVK_E)) {
 		player.Change_Spell(true);
+		game_replay.Record(tick, Replay::CHANGE_SPELL, 0, 0, 1);
 	}
 	else if (AEInputCheckTriggered(AEVK_Q)) {
 		player.Change_Spell(false);
+		game_replay.Record(tick, Replay::CHANGE_SPELL, 0, 0, 0);
 	}
 }
 
@@ -23,11 +23,13 @@ extern s8 PLAYER_WATER_RANGE;
 extern s8 PLAYER_EARTH_RANGE;
 extern s8 PLAYER_AIR_RANGE;
 
+class World;
+
 class Player
 {
 private:
-	s8 intital_x{}, initial_y{};
-	s8 x{}, y{};
+	s32 intital_x{}, initial_y{};
+	s32 x{}, y{};
 	// Variable facing is currently not used. This will be used when adding
 	// more images/textures to show where the player is moving towards
 	u8 facing{}, selected_spell{};
@@ -43,6 +45,8 @@ private:
 	AEGfxTexture* earth_spell_texture{ nullptr };
 	AEGfxTexture* air_spell_texture{ nullptr };
 
+	World* world{ nullptr };		// The World this player is in
+
 public:
 
 	enum SPELL : u8 {
@@ -53,16 +57,21 @@ public:
 		UP, DOWN, LEFT, RIGHT
 	};
 
-	void Load(s8 player_initial_x, s8 player_initial_y);
+	void Set_World(World& owner);
+	void Load(s32 player_initial_x, s32 player_initial_y);
+	void Load_Assets();
 	void Initialize();
+	void Restore(Player const& saved);
 	void Change_Spell(bool forward);
+	void Select_Spell(bool forward);
 	bool Castable();
-	bool Cast(s8 grid_x, s8 grid_y);
+	bool Cast(s32 grid_x, s32 grid_y);
+	bool Cast_Spell(s32 grid_x, s32 grid_y);
 	bool Move(u8 direction);
 	bool Moveable();
 	void Unload();
 	void Get_Player_World_Coordinates(f32& x, f32& y);
-	void Get_Player_Tiles_Coordinates(s8& x, s8& y); 
+	void Get_Player_Tiles_Coordinates(s32& x, s32& y); 
 
 	// Graphics related Functions
 	friend void Draw_Player(Player& player);
@@ -71,6 +80,6 @@ public:
 };
 
 
-extern Player player;
+extern Player& player;
 
 void Player_Input();
\ No newline at end of file
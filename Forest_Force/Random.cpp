@@ -0,0 +1,208 @@
+/******************************************************************************/
+/*!
+\file		Random.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This is the source file for the random number service. Random is
+			a small seedable xoshiro128** generator, each thread gets its own
+			from Thread_Random, so no locks are taken and a run can be
+			replayed from its seed.
+			The main functions of Random.cpp are:
+			-Seed_Random
+				Sets the seed every thread's generator is derived from
+			-Thread_Random
+				Returns the calling thread's generator
+			-Fill_Range
+				Writes a whole burst of random floats in one call
+
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Random.hpp"
+#include <atomic>						// Seed shared by every thread
+
+namespace
+{
+	std::atomic<u64> random_seed{ 0x5EED5EED5EED5EEDull };
+	std::atomic<u32> seed_generation{ 1 };		// Bumped by Seed_Random, threads reseed when theirs is older
+	std::atomic<u32> next_stream{};				// Stream 0 goes to the thread that called Seed_Random
+
+	/**************************************************************************/
+	/*!
+		Splitmix64, spreads a seed out so that close seeds give unrelated
+		generator states
+	*/
+	/**************************************************************************/
+	u64 Split_Mix(u64& value)
+	{
+		u64 z{ value += 0x9E3779B97F4A7C15ull };
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	/**************************************************************************/
+	/*!
+		Rotates the bits of value left by shift
+	*/
+	/**************************************************************************/
+	u32 Rotate_Left(u32 value, s32 shift)
+	{
+		return (value << shift) | (value >> (32 - shift));
+	}
+
+	/**************************************************************************/
+	/*!
+		Seed of the generator for one stream of the current seed
+	*/
+	/**************************************************************************/
+	u64 Stream_Seed(u32 stream)
+	{
+		return random_seed.load() ^ (static_cast<u64>(stream) * 0xD1B54A32D192ED03ull);
+	}
+}
+
+/**************************************************************************/
+/*!
+	Random Constructor, seeds the generator
+*/
+/**************************************************************************/
+Random::Random(u64 seed)
+{
+	Seed(seed);
+}
+
+/**************************************************************************/
+/*!
+	This function restarts the generator from seed, the same seed always
+	gives the same numbers
+*/
+/**************************************************************************/
+void Random::Seed(u64 seed)
+{
+	u64 first{ Split_Mix(seed) };
+	u64 second{ Split_Mix(seed) };
+	state[0] = static_cast<u32>(first);
+	state[1] = static_cast<u32>(first >> 32);
+	state[2] = static_cast<u32>(second);
+	state[3] = static_cast<u32>(second >> 32);
+	// xoshiro never leaves the all zero state
+	if (!(state[0] | state[1] | state[2] | state[3]))
+	{
+		state[0] = 1;
+	}
+}
+
+/**************************************************************************/
+/*!
+	This function returns the next 32 random bits
+*/
+/**************************************************************************/
+u32 Random::Next()
+{
+	u32 result{ Rotate_Left(state[1] * 5, 7) * 9 };
+	u32 shifted{ state[1] << 9 };
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= shifted;
+	state[3] = Rotate_Left(state[3], 11);
+	return result;
+}
+
+/**************************************************************************/
+/*!
+	This function returns a random float in [0, 1), from the top 24 bits
+	so every value is exactly representable
+*/
+/**************************************************************************/
+f32 Random::Next_Float()
+{
+	return static_cast<f32>(Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+/**************************************************************************/
+/*!
+	This function returns a random float given a min and a max
+*/
+/**************************************************************************/
+f32 Random::Range(f32 min, f32 max)
+{
+	return min + Next_Float() * (max - min);
+}
+
+/**************************************************************************/
+/*!
+	This function returns a random integer from min to max, both included
+*/
+/**************************************************************************/
+s32 Random::Range_Int(s32 min, s32 max)
+{
+	u64 span{ static_cast<u64>(static_cast<s64>(max) - min + 1) };
+	return static_cast<s32>(min + static_cast<s64>((static_cast<u64>(Next()) * span) >> 32));
+}
+
+/**************************************************************************/
+/*!
+	This function writes count random floats between min and max to out,
+	used to roll a whole burst of particles at once
+*/
+/**************************************************************************/
+void Random::Fill_Range(f32* out, size_t count, f32 min, f32 max)
+{
+	f32 const scale{ (max - min) * (1.0f / 16777216.0f) };
+	for (size_t i{}; i < count; ++i)
+	{
+		out[i] = min + static_cast<f32>(Next() >> 8) * scale;
+	}
+}
+
+/**************************************************************************/
+/*!
+	This function sets the seed of every thread's generator. The calling
+	thread restarts from seed at once, other threads pick up their own
+	streams of it the next time they ask for their generator
+*/
+/**************************************************************************/
+void Seed_Random(u64 seed)
+{
+	random_seed = seed;
+	next_stream = 0;
+	++seed_generation;
+	Thread_Random();
+}
+
+/**************************************************************************/
+/*!
+	Accessor function to the seed set by Seed_Random
+*/
+/**************************************************************************/
+u64 Get_Random_Seed()
+{
+	return random_seed;
+}
+
+/**************************************************************************/
+/*!
+	This function returns the calling thread's generator, seeded from its
+	own stream of the seed on first use and after every Seed_Random
+*/
+/**************************************************************************/
+Random& Thread_Random()
+{
+	thread_local Random generator{};
+	thread_local u32 generation{};
+	u32 const latest{ seed_generation.load() };
+	if (generation != latest)
+	{
+		generation = latest;
+		generator.Seed(Stream_Seed(next_stream++));
+	}
+	return generator;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************/
+/*!
+\file		Random.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This is the header file for the random number service. Random is
+			a small seedable xoshiro128** generator, each thread gets its own
+			from Thread_Random, so no locks are taken and a run can be
+			replayed from its seed.
+			The main functions of Random.cpp are:
+			-Seed_Random
+				Sets the seed every thread's generator is derived from
+			-Thread_Random
+				Returns the calling thread's generator
+			-Fill_Range
+				Writes a whole burst of random floats in one call
+
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+
+class Random
+{
+	u32 state[4]{};
+
+public:
+	Random(u64 seed = 0);
+
+	void Seed(u64 seed);
+
+	u32 Next();
+
+	f32 Next_Float();
+
+	f32 Range(f32 min, f32 max);
+
+	s32 Range_Int(s32 min, s32 max);
+
+	void Fill_Range(f32* out, size_t count, f32 min, f32 max);
+};
+
+void Seed_Random(u64 seed);
+
+u64 Get_Random_Seed();
+
+Random& Thread_Random();
@@ -0,0 +1,285 @@
+/******************************************************************************/
+/*!
+\file		Replay.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Replay class. A Replay records the player
+			commands of a level stamped with the tick they landed before, and
+			plays them back through the fixed tick simulation. The simulation
+			only depends on the commands and the ticks, so a replay gives the
+			same World every time, headless and as fast as the CPU allows.
+			The main functions of Replay.cpp are:
+			-Start_Recording / Record / Stop_Recording
+				Records the commands of one attempt at a level
+			-Save / Load
+				Writes and reads a replay file
+			-Play
+				Runs a replay headless and checks it ends like the recording
+			-Check_Replay
+				Loads a replay file and its level and plays it, for the
+				--replay command line flag
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Replay.hpp"
+#include "World.hpp"
+#include "Random.hpp"
+#include <cstdlib>						// std::strtoull
+
+Replay game_replay;
+
+namespace
+{
+	/**************************************************************************/
+	/*!
+		Returns how a World ended up
+	*/
+	/**************************************************************************/
+	Replay_Result Get_Result(World& world)
+	{
+		Replay_Result result{};
+		result.defeated = world.state == LS_DEFEAT;
+		result.tree_count = world.map.Wood_Count();
+		result.house_durability = world.map.Get_Curr_House_Durability();
+		result.burning_tiles = static_cast<s32>(world.map.Get_Burning_Tiles().size());
+		world.player.Get_Player_Tiles_Coordinates(result.player_x, result.player_y);
+		result.state_hash = world.Get_State_Hash();
+		return result;
+	}
+
+	/**************************************************************************/
+	/*!
+		Gives a recorded command to the player of a World
+	*/
+	/**************************************************************************/
+	void Apply_Command(World& world, Player_Command const& command)
+	{
+		switch (command.command)
+		{
+		case Replay::MOVE:
+			world.player.Move(static_cast<u8>(command.value));
+			break;
+		case Replay::CAST:
+			world.player.Cast_Spell(command.x, command.y);
+			break;
+		case Replay::CHANGE_SPELL:
+			world.player.Select_Spell(command.value != 0);
+			break;
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function compares two results, the state hashes tell apart Worlds
+	 that only differ in tiles the counts do not see
+*/
+/**************************************************************************/
+bool Replay_Result::operator==(Replay_Result const& rhs) const
+{
+	return defeated == rhs.defeated && tree_count == rhs.tree_count && house_durability == rhs.house_durability
+		&& burning_tiles == rhs.burning_tiles && player_x == rhs.player_x && player_y == rhs.player_y
+		&& (state_hash == 0 || rhs.state_hash == 0 || state_hash == rhs.state_hash);
+}
+
+/**************************************************************************/
+/*!
+	 This function starts a new recording of a level, dropping the last one
+*/
+/**************************************************************************/
+void Replay::Start_Recording(std::string const& level, u64 random_seed)
+{
+	level_file = level;
+	seed = random_seed;
+	ticks = 0;
+	result = Replay_Result{};
+	commands.clear();
+	recording = true;
+}
+
+/**************************************************************************/
+/*!
+	 This function records a player command that was given after tick
+	 ticks had run
+*/
+/**************************************************************************/
+void Replay::Record(s32 tick, u8 command, s32 x_value, s32 y_value, s8 value)
+{
+	if (!recording)
+		return;
+	commands.push_back(Player_Command{ tick, command, value, x_value, y_value });
+}
+
+/**************************************************************************/
+/*!
+	 This function drops the commands given once tick ticks had run, when
+	 the World has been rewound to it. A rewind drops the spells queued for
+	 the next tick and puts the player back to before they were given, so
+	 the commands stamped with tick go as well
+*/
+/**************************************************************************/
+void Replay::Truncate(s32 tick)
+{
+	while (!commands.empty() && commands.back().tick >= tick)
+	{
+		commands.pop_back();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function stops recording and keeps how the World ended up
+*/
+/**************************************************************************/
+void Replay::Stop_Recording(World& world)
+{
+	if (!recording)
+		return;
+	ticks = world.Get_Ticks_Run();
+	result = Get_Result(world);
+	recording = false;
+}
+
+/**************************************************************************/
+/*!
+	 This function writes the replay to a file, one command a line
+*/
+/**************************************************************************/
+bool Replay::Save(std::string const& filename)
+{
+	std::ofstream output_file{ filename };
+	if (!output_file)
+		return false;
+
+	output_file << "Level : " << level_file << '\n';
+	output_file << "Seed : " << seed << '\n';
+	output_file << "Ticks : " << ticks << '\n';
+	output_file << "Result : " << result.defeated << ' ' << result.tree_count << ' ' << result.house_durability << ' '
+		<< result.burning_tiles << ' ' << result.player_x << ' ' << result.player_y << ' ' << result.state_hash << '\n';
+	output_file << "Commands : " << commands.size() << '\n';
+	for (Player_Command const& command : commands)
+	{
+		output_file << command.tick << ' ' << static_cast<s32>(command.command) << ' ' << command.x << ' '
+			<< command.y << ' ' << static_cast<s32>(command.value) << '\n';
+	}
+	return static_cast<bool>(output_file);
+}
+
+/**************************************************************************/
+/*!
+	 This function reads a replay written by Save
+*/
+/**************************************************************************/
+bool Replay::Load(std::string const& filename)
+{
+	std::ifstream input_file{ filename };
+	if (!input_file)
+		return false;
+
+	std::string label{}, colon{};
+	size_t command_count{};
+	input_file >> label >> colon >> level_file;
+	input_file >> label >> colon >> seed;
+	input_file >> label >> colon >> ticks;
+	input_file >> label >> colon >> result.defeated >> result.tree_count >> result.house_durability
+		>> result.burning_tiles >> result.player_x >> result.player_y;
+	// Replays saved before the state hash was kept end the line here
+	std::string hash_text{};
+	std::getline(input_file, hash_text);
+	result.state_hash = std::strtoull(hash_text.c_str(), nullptr, 10);
+	input_file >> label >> colon >> command_count;
+
+	commands.clear();
+	recording = false;
+	for (size_t i{}; i < command_count; ++i)
+	{
+		Player_Command command{};
+		s32 type{}, value{};
+		if (!(input_file >> command.tick >> type >> command.x >> command.y >> value))
+			return false;
+		command.command = static_cast<u8>(type);
+		command.value = static_cast<s8>(value);
+		commands.push_back(command);
+	}
+	return static_cast<bool>(input_file);
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the level file the replay was recorded on
+*/
+/**************************************************************************/
+std::string const& Replay::Get_Level_File()
+{
+	return level_file;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of ticks the recording ran for
+*/
+/**************************************************************************/
+s32 Replay::Get_Ticks()
+{
+	return ticks;
+}
+
+/**************************************************************************/
+/*!
+	 This function plays the replay on a World with its level loaded, from
+	 the start of the level, without waiting on frame time. Returns true if
+	 the World ended up the way the recording did
+*/
+/**************************************************************************/
+bool Replay::Play(World& world)
+{
+	Seed_Random(seed);
+	world.Initialize();
+
+	size_t command_index{};
+	for (s32 tick{};; ++tick)
+	{
+		while (command_index < commands.size() && commands[command_index].tick <= tick)
+		{
+			Apply_Command(world, commands[command_index++]);
+		}
+		if (tick >= ticks)
+			break;
+		world.Run_Ticks(1);
+	}
+	return Get_Result(world) == result;
+}
+
+/**************************************************************************/
+/*!
+	 This function loads a replay file, plays it on a World of its own with
+	 the replay's level loaded and reports whether it ended the way the
+	 recording did, state hash included. Returns false if the replay or its
+	 level could not be loaded or the World ended up differently
+*/
+/**************************************************************************/
+bool Check_Replay(std::string const& filename)
+{
+	Replay replay{};
+	if (!replay.Load(filename))
+	{
+		std::cout << "Replay " << filename << " could not be loaded\n";
+		return false;
+	}
+	World world{};
+	if (!world.Load(replay.Get_Level_File()))
+	{
+		std::cout << "Level " << replay.Get_Level_File() << " of replay " << filename << " could not be loaded\n";
+		return false;
+	}
+
+	bool const matched{ replay.Play(world) };
+	std::cout << "Replay " << filename << (matched ? " matched" : " did not match") << " its recording after "
+		<< replay.Get_Ticks() << " ticks, state hash " << world.Get_State_Hash() << '\n';
+	return matched;
+}
@@ -0,0 +1,90 @@
+/******************************************************************************/
+/*!
+\file		Replay.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Replay class. A Replay records the player
+			commands of a level stamped with the tick they landed before, and
+			plays them back through the fixed tick simulation. The simulation
+			only depends on the commands and the ticks, so a replay gives the
+			same World every time, headless and as fast as the CPU allows.
+			The main functions of Replay.cpp are:
+			-Start_Recording / Record / Stop_Recording
+				Records the commands of one attempt at a level
+			-Save / Load
+				Writes and reads a replay file
+			-Play
+				Runs a replay headless and checks it ends like the recording
+			-Check_Replay
+				Loads a replay file and its level and plays it, for the
+				--replay command line flag
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+
+class World;
+
+// A player command, applied after tick ticks have run
+struct Player_Command
+{
+	s32 tick{};
+	u8 command{};				// Replay::COMMAND
+	s8 value{};					// Direction of MOVE, 1 for the next spell of CHANGE_SPELL
+	s32 x{}, y{};				// Tile of CAST
+};
+
+// How a World ended up, to check a replay against its recording
+struct Replay_Result
+{
+	bool defeated{};
+	s32 tree_count{};
+	s16 house_durability{};
+	s32 burning_tiles{};
+	s32 player_x{}, player_y{};
+	u64 state_hash{};					// World::Get_State_Hash, 0 in replays saved without it
+
+	bool operator==(Replay_Result const& rhs) const;
+};
+
+class Replay
+{
+	std::string level_file{};
+	u64 seed{};
+	s32 ticks{};						// Ticks run when the recording stopped
+	Replay_Result result{};
+	std::vector<Player_Command> commands{};	// In tick order
+	bool recording{ false };
+
+public:
+	enum COMMAND : u8 {
+		MOVE = 0, CAST, CHANGE_SPELL
+	};
+
+	void Start_Recording(std::string const& level, u64 random_seed);
+
+	void Record(s32 tick, u8 command, s32 x_value, s32 y_value, s8 value);
+
+	void Truncate(s32 tick);
+
+	void Stop_Recording(World& world);
+
+	bool Save(std::string const& filename);
+
+	bool Load(std::string const& filename);
+
+	std::string const& Get_Level_File();
+
+	s32 Get_Ticks();
+
+	bool Play(World& world);
+};
+
+extern Replay game_replay;
+
+bool Check_Replay(std::string const& filename);
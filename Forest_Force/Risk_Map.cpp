@@ -0,0 +1,259 @@
+/******************************************************************************/
+/*!
+\file		Risk_Map.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Risk_Map class. The risk map clones the
+			Map being played and runs many short simulations ahead of it with
+			the fire spreading by chance, split across the thread pool. The
+			share of runs a tile burnt in within RISK_TIME seconds is its
+			risk, drawn over the Map while the player has it shown.
+			Runs cost at most RISK_BUDGET seconds a frame and stop once
+			RISK_RUNS runs of the current state are in. When a tick runs or a
+			spell is cast the runs so far are weighed down instead of thrown
+			away, so the map refreshes a little every frame.
+			The main functions of Risk_Map.cpp are:
+			-Toggle
+				Shows or hides the risk map, runs are only made while shown
+			-Update
+				Spends the frame's budget on runs from the Map as it is now
+			-Get_Risk
+				Chance from 0 to 1 that a tile burns within RISK_TIME
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Risk_Map.hpp"
+#include "Thread_Pool.hpp"
+#include <chrono>						// Times the runs against the budget
+#include <cmath>						// std::ceil
+
+Risk_Map risk_map;
+
+namespace
+{
+	// Weight the runs of a state keep once the Map has moved on from it
+	const f32 STALE_WEIGHT{ 0.5f };
+	// Spreads run numbers out into unrelated spread roll seeds
+	const u64 RUN_SEED_STEP{ 0x2545F4914F6CDD1Dull };
+
+	/**************************************************************************/
+	/*!
+		Counts the tiles burning on a slot's Map for its current run, each
+		tile once a run
+	*/
+	/**************************************************************************/
+	void Count_Burning(Risk_Slot& slot)
+	{
+		for (s32 tile : slot.map.Get_Burning_Tiles())
+		{
+			if (slot.last_run[tile] == slot.runs)
+				continue;
+			slot.last_run[tile] = slot.runs;
+			if (slot.hits[tile]++ == 0)
+			{
+				slot.touched.push_back(tile);
+			}
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 Risk_Map Destructor, frees the Maps of the slots
+*/
+/**************************************************************************/
+Risk_Map::~Risk_Map()
+{
+	Free();
+}
+
+/**************************************************************************/
+/*!
+	 This function shows or hides the risk map. It starts over from no
+	 runs every time it is shown
+*/
+/**************************************************************************/
+void Risk_Map::Toggle()
+{
+	shown = !shown;
+	if (shown)
+	{
+		Reset();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to whether the risk map is shown
+*/
+/**************************************************************************/
+bool Risk_Map::Is_Shown()
+{
+	return shown;
+}
+
+/**************************************************************************/
+/*!
+	 This function makes runs from source as it is now, split across the
+	 thread pool, for at most RISK_BUDGET seconds. Once RISK_RUNS runs of
+	 the current state are in it does nothing until source changes
+*/
+/**************************************************************************/
+void Risk_Map::Update(Map& source)
+{
+	if (!shown || source.Get_X_Size() <= 0 || source.Get_Y_Size() <= 0 || BEHAVIOUR_TIME <= 0)
+		return;
+
+	if (x_size != source.Get_X_Size() || y_size != source.Get_Y_Size())
+	{
+		x_size = source.Get_X_Size();
+		y_size = source.Get_Y_Size();
+		Reset();
+	}
+
+	u32 version{ source.Get_State_Version() };
+	if (has_source && version != source_version)
+	{
+		// Runs of the state before still say a lot about this one
+		for (f32& weight : burn_weight)
+		{
+			weight *= STALE_WEIGHT;
+		}
+		run_weight *= STALE_WEIGHT;
+	}
+	source_version = version;
+	has_source = true;
+	if (run_weight >= static_cast<f32>(RISK_RUNS))
+		return;
+
+	s32 slot_count{ thread_pool.Get_Thread_Count() };
+	while (static_cast<s32>(slots.size()) < slot_count)
+	{
+		slots.push_back(std::make_unique<Risk_Slot>());
+	}
+
+	// Runs per slot, as many as are missing or fit in the budget, one to time them first
+	s32 missing{ static_cast<s32>(std::ceil(static_cast<f32>(RISK_RUNS) - run_weight)) };
+	s32 runs{ (missing + slot_count - 1) / slot_count };
+	runs = run_time > 0 ? std::min(runs, std::max(static_cast<s32>(RISK_BUDGET / run_time), 1)) : 1;
+
+	u64 const first_seed{ batch_seed };
+	batch_seed += static_cast<u64>(slot_count) * static_cast<u64>(runs);
+	std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+	thread_pool.Run(slot_count, [this, &source, runs, first_seed](s32 slot_index)
+		{
+			Run_Slot(*slots[slot_index], source, runs, first_seed + static_cast<u64>(slot_index) * static_cast<u64>(runs));
+		});
+	f64 seconds{ std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count() / runs };
+	run_time = run_time > 0 ? run_time * 0.75 + seconds * 0.25 : seconds;
+
+	// Slots only hold the tiles they hit, so merging costs the fire and not the Map
+	for (s32 i{}; i < slot_count; ++i)
+	{
+		Risk_Slot& slot = *slots[i];
+		for (s32 tile : slot.touched)
+		{
+			burn_weight[tile] += static_cast<f32>(slot.hits[tile]);
+			slot.hits[tile] = 0;
+		}
+		slot.touched.clear();
+	}
+	run_weight += static_cast<f32>(slot_count * runs);
+}
+
+/**************************************************************************/
+/*!
+	 This function makes runs on one slot, counting the tiles that burn in
+	 each. The slot's Map is cloned from source again only when source has
+	 changed, every run after that restores its snapshot, which writes
+	 back just the tiles the last run changed
+*/
+/**************************************************************************/
+void Risk_Map::Run_Slot(Risk_Slot& slot, Map& source, s32 runs, u64 first_seed)
+{
+	size_t tiles{ static_cast<size_t>(x_size) * static_cast<size_t>(y_size) };
+	if (!slot.cloned || slot.version != source_version)
+	{
+		slot.map.Clone_From(source);
+		// Spells waiting for the next tick are in every run
+		slot.map.Apply_Commands();
+		slot.snapshot = slot.map.Take_Snapshot();
+		slot.version = source_version;
+		slot.cloned = true;
+	}
+	if (slot.hits.size() != tiles)
+	{
+		slot.hits.assign(tiles, 0);
+		slot.last_run.assign(tiles, -1);
+		slot.touched.clear();
+	}
+
+	s32 ticks{ std::max(static_cast<s32>(RISK_TIME / BEHAVIOUR_TIME), 1) };
+	for (s32 run{}; run < runs; ++run)
+	{
+		slot.map.Restore_Snapshot(slot.snapshot);
+		slot.map.Set_Spread_Chance(RISK_SPREAD_CHANCE, (first_seed + static_cast<u64>(run)) * RUN_SEED_STEP);
+		++slot.runs;
+		// Tiles burning now are burning within RISK_TIME too
+		Count_Burning(slot);
+		for (s32 tick{}; tick < ticks; ++tick)
+		{
+			slot.map.Simulate_Tick();
+			Count_Burning(slot);
+		}
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the chance from 0 to 1 that a tile burns within
+	 RISK_TIME seconds, 0 before any runs are in
+*/
+/**************************************************************************/
+f32 Risk_Map::Get_Risk(s32 x_value, s32 y_value)
+{
+	if (run_weight <= 0 || x_value < 0 || y_value < 0 || x_value >= x_size || y_value >= y_size)
+		return 0.0f;
+	return std::min(burn_weight[static_cast<size_t>(y_value) * static_cast<size_t>(x_size) + static_cast<size_t>(x_value)] / run_weight, 1.0f);
+}
+
+/**************************************************************************/
+/*!
+	 This function drops every run made, the slots clone the Map again on
+	 the next Update
+*/
+/**************************************************************************/
+void Risk_Map::Reset()
+{
+	burn_weight.assign(static_cast<size_t>(x_size) * static_cast<size_t>(y_size), 0.0f);
+	run_weight = 0;
+	has_source = false;
+	for (std::unique_ptr<Risk_Slot>& slot : slots)
+	{
+		slot->cloned = false;
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function frees the slots and their Maps, when the level is
+	 unloaded
+*/
+/**************************************************************************/
+void Risk_Map::Free()
+{
+	for (std::unique_ptr<Risk_Slot>& slot : slots)
+	{
+		slot->map.Map_Unload();
+	}
+	slots.clear();
+	burn_weight.clear();
+	run_weight = 0;
+	x_size = y_size = 0;
+	has_source = false;
+}
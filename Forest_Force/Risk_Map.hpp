@@ -0,0 +1,87 @@
+/******************************************************************************/
+/*!
+\file		Risk_Map.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Risk_Map class. The risk map clones the
+			Map being played and runs many short simulations ahead of it with
+			the fire spreading by chance, split across the thread pool. The
+			share of runs a tile burnt in within RISK_TIME seconds is its
+			risk, drawn over the Map while the player has it shown.
+			Runs cost at most RISK_BUDGET seconds a frame and stop once
+			RISK_RUNS runs of the current state are in. When a tick runs or a
+			spell is cast the runs so far are weighed down instead of thrown
+			away, so the map refreshes a little every frame.
+			The main functions of Risk_Map.cpp are:
+			-Toggle
+				Shows or hides the risk map, runs are only made while shown
+			-Update
+				Spends the frame's budget on runs from the Map as it is now
+			-Get_Risk
+				Chance from 0 to 1 that a tile burns within RISK_TIME
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+#include "Map.hpp"
+#include <memory>						// Slots own their Map
+
+extern f64 RISK_TIME;
+extern f32 RISK_SPREAD_CHANCE;
+extern s32 RISK_RUNS;
+extern f64 RISK_BUDGET;
+
+// The Map one thread runs simulations on, cloned once per state of the
+// source and brought back to it between runs through a snapshot
+struct Risk_Slot
+{
+	Map map{};
+	s32 snapshot{ -1 };
+	u32 version{};						// State version of the source the map was cloned from
+	bool cloned{};
+	std::vector<u32> hits{};			// Runs of this batch each tile burnt in
+	std::vector<s32> last_run{};		// Last run each tile was counted for
+	std::vector<s32> touched{};			// Tiles with hits this batch
+	s32 runs{};							// Runs made on this slot, tells runs apart in last_run
+};
+
+class Risk_Map
+{
+	std::vector<std::unique_ptr<Risk_Slot>> slots{};
+	std::vector<f32> burn_weight{};		// Weighted runs each tile burnt in
+	f32 run_weight{};					// Weighted runs made, older states weigh less
+	s32 x_size{};
+	s32 y_size{};
+	u32 source_version{};
+	bool has_source{};
+	bool shown{};
+	u64 batch_seed{};
+	f64 run_time{};						// Seconds one run takes on one thread, averaged
+
+	void Run_Slot(Risk_Slot& slot, Map& source, s32 runs, u64 first_seed);
+
+public:
+	Risk_Map() = default;
+	Risk_Map(Risk_Map const&) = delete;
+	Risk_Map& operator=(Risk_Map const&) = delete;
+	~Risk_Map();
+
+	void Toggle();
+
+	bool Is_Shown();
+
+	void Update(Map& source);
+
+	f32 Get_Risk(s32 x_value, s32 y_value);
+
+	void Reset();
+
+	void Free();
+};
+
+extern Risk_Map risk_map;
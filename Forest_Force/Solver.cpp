@@ -0,0 +1,780 @@
+/******************************************************************************/
+/*!
+\file		Solver.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Solver class. The solver plays a level file
+			headless, searching over the player's moves and spells one tick at
+			a time against the fixed tick simulation, and finds out which
+			combinations of the level's objectives can be won together. Every
+			combination found comes with a witness, a Replay that wins it.
+			The search is depth first and steps back through the World's
+			rewind ring. States whose every move was searched without a win
+			go into a transposition table shared by all threads, so no thread
+			searches them again. Moves that lose the level or fail an
+			objective being kept are cut off at once.
+			Each thread searches with its own World and its own order of
+			trying moves, some run for the arsonist first and some fight the
+			fire first.
+			The player does one thing a tick, moving, casting or waiting, and
+			spells are only aimed at the tiles that matter most to the fire, so
+			a witness can always be played by hand. A combination that is not
+			found was either not reached in SOLVE_TIME or cannot be won that
+			way within SOLVE_HORIZON seconds.
+			The main functions of Solver.cpp are:
+			-Solve
+				Searches a level file for every combination of its objectives
+			-Get_Results
+				Whether each combination was won, with its witness
+			-Get_Max_Stars
+				Most stars any witness wins
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Solver.hpp"
+#include "Thread_Pool.hpp"
+#include "Random.hpp"
+#include <algorithm>					// std::stable_sort, std::partial_sort
+#include <chrono>						// Times the search against SOLVE_TIME
+
+namespace
+{
+	// States the transposition table holds, a power of two
+	const size_t DEAD_STATES_SIZE{ size_t{ 1 } << 20 };
+	// Tiles each spell is tried on, the ones that matter most to the fire
+	const size_t CAST_TARGETS{ 3 };
+	// Orders of trying actions, threads take turns
+	enum STRATEGY : s32 {
+		RUN = 0, FIGHT, STRATEGIES
+	};
+	const s32 FAR{ 0x7FFFFFFF };		// Distance of tiles the arsonist cannot be reached from
+	// Cost of stepping onto a tile, in moves, see Step_Cost
+	const s32 BURNING_COST{ 3 };		// Has to burn out or be put out first
+	const s32 WEARING_COST{ 3 };		// Earth wearing down to a hill
+	const s32 EARTH_COST{ 5 };			// Has to be turned to earth and wear down first
+	const s32 MOST_COST{ 5 };
+
+	// Tile offsets of Player::DIRECTION
+	const s32 DIRECTION_X[4]{ 0, 0, -1, 1 };
+	const s32 DIRECTION_Y[4]{ 1, -1, 0, 0 };
+
+	/**************************************************************************/
+	/*!
+		Mixes a value into a hash
+	*/
+	/**************************************************************************/
+	u64 Mix(u64 hash, u64 value)
+	{
+		hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+		hash ^= hash >> 31;
+		hash *= 0xBF58476D1CE4E5B9ull;
+		return hash ^ (hash >> 29);
+	}
+
+	/**************************************************************************/
+	/*!
+		Returns the ticks a cooldown of seconds keeps the player waiting,
+		counting the tick it starts on
+	*/
+	/**************************************************************************/
+	s32 Cooldown_Ticks(f64 seconds)
+	{
+		return static_cast<s32>(seconds / BEHAVIOUR_TIME) + 1;
+	}
+
+	/**************************************************************************/
+	/*!
+		Returns what stepping onto a tile costs on the way to the arsonist.
+		Earth can be put on any tile but the arsonist's, and wears down to a
+		hill the player can cross before it is gone, which is how rivers,
+		trees and mountains are got past. FAR if it can never be stepped on
+	*/
+	/**************************************************************************/
+	s32 Step_Cost(Tiles const& tile)
+	{
+		if (tile.Is_Passable())
+			return tile.Get_Fire() > 0 ? BURNING_COST : 1;
+		if (tile.Get_Terrain_Type() == Map::ENEMY)
+			return FAR;
+		if (!tile.Is_Earth_Permanant() && tile.Get_Earth_Durability() > 0)
+			return WEARING_COST;
+		return EARTH_COST;
+	}
+
+	/**************************************************************************/
+	/*!
+		Counts the tiles around a tile that fire could still take, the more
+		there are the more a spell there is worth
+	*/
+	/**************************************************************************/
+	s32 Fuel_Around(Tile_Grid const& grid, s32 x_value, s32 y_value)
+	{
+		s32 fuel{};
+		for (s32 y_offset{ -1 }; y_offset <= 1; ++y_offset)
+		{
+			for (s32 x_offset{ -1 }; x_offset <= 1; ++x_offset)
+			{
+				Tiles const& tile = grid[y_value + y_offset][x_value + x_offset];
+				u8 terrain{ tile.Get_Terrain_Type() };
+				if (tile.Get_Fire() <= 0 && (terrain == Map::TREE || terrain == Map::BUSH || terrain == Map::HOUSE))
+				{
+					++fuel;
+				}
+			}
+		}
+		return fuel;
+	}
+
+	/**************************************************************************/
+	/*!
+		Adds the CAST_TARGETS best scored targets to the actions
+	*/
+	/**************************************************************************/
+	void Add_Best(std::vector<std::pair<s32, Solver_Action>>& targets, std::vector<Solver_Action>& actions)
+	{
+		size_t count{ std::min(targets.size(), CAST_TARGETS) };
+		std::partial_sort(targets.begin(), targets.begin() + static_cast<ptrdiff_t>(count), targets.end(),
+			[](std::pair<s32, Solver_Action> const& lhs, std::pair<s32, Solver_Action> const& rhs) { return lhs.first > rhs.first; });
+		for (size_t i{}; i < count; ++i)
+		{
+			actions.push_back(targets[i].second);
+		}
+	}
+
+	/**************************************************************************/
+	/*!
+		Gives an action to the player of a World, selecting the spell first
+		if it is not the one selected. The commands given are recorded to
+		witness when there is one. Returns false if the player could not
+		do it
+	*/
+	/**************************************************************************/
+	bool Apply_Action(World& world, Solver_Action const& action, s8& spell, s32 tick, Replay* witness)
+	{
+		switch (action.action)
+		{
+		case Solver::MOVE:
+			if (!world.player.Move(static_cast<u8>(action.value)))
+				return false;
+			if (witness)
+				witness->Record(tick, Replay::MOVE, 0, 0, action.value);
+			break;
+		case Solver::CAST:
+			while (spell != action.value)
+			{
+				world.player.Select_Spell(true);
+				spell = static_cast<s8>((spell + 1) % Player::TOTAL_SPELLS);
+				if (witness)
+					witness->Record(tick, Replay::CHANGE_SPELL, 0, 0, 1);
+			}
+			if (!world.player.Cast_Spell(action.x, action.y))
+				return false;
+			if (witness)
+				witness->Record(tick, Replay::CAST, action.x, action.y, 0);
+			break;
+		}
+		return true;
+	}
+
+	/**************************************************************************/
+	/*!
+		Takes the World back one tick to a state on the search path
+	*/
+	/**************************************************************************/
+	void Step_Back(World& world, Solver_Node const& node)
+	{
+		world.Rewind(1);
+		world.player.Restore(node.player);
+		world.state = LS_PLAYING;
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the goals the tick just run failed, the same
+	 way Objectives::Update fails them
+*/
+/**************************************************************************/
+u8 Solver::Failed_Goals(World& world)
+{
+	bool tree_burnt{ false }, houses_destroyed{ false };
+	for (Map_Event const& event : world.Get_Events())
+	{
+		tree_burnt = tree_burnt || event.event == Map::TREE_BURNT;
+		houses_destroyed = houses_destroyed || event.event == Map::HOUSES_DESTROYED;
+	}
+
+	u8 failed{};
+	if (goals.time_limit && world.Get_Ticks_Run() * BEHAVIOUR_TIME > goals.time_limit_seconds)
+	{
+		failed |= TIME_LIMIT;
+	}
+	if (goals.tree_count && tree_burnt && world.map.Wood_Count() < goals.trees_limit)
+	{
+		failed |= TREE_COUNT;
+	}
+	if (goals.save_house && houses_destroyed && !world.map.Get_Curr_House_Durability())
+	{
+		failed |= SAVE_HOUSE;
+	}
+	return failed;
+}
+
+/**************************************************************************/
+/*!
+	 This function hashes a state of the search, the World, what the
+	 player can do next and the goals being kept. The World's hash is kept
+	 up to date by the Map as it runs, so this costs nothing per tile
+*/
+/**************************************************************************/
+u64 Solver::State_Hash(World& world, Solver_Node const& node, u8 kept)
+{
+	s32 const tick{ world.Get_Ticks_Run() };
+	u64 hash{ Mix(kept, static_cast<u64>(tick)) };
+	hash = Mix(hash, world.Get_State_Hash());
+	hash = Mix(hash, static_cast<u64>(node.failed) << 8 | static_cast<u8>(node.spell));
+	hash = Mix(hash, static_cast<u64>(std::max(node.move_tick - tick, 0)));
+	for (s32 spell{}; spell < Player::TOTAL_SPELLS; ++spell)
+	{
+		hash = Mix(hash, static_cast<u64>(std::max(node.spell_tick[spell] - tick, 0)));
+	}
+	// 0 marks an empty slot of the table
+	return hash | 1;
+}
+
+/**************************************************************************/
+/*!
+	 This function checks if a state was already searched without a win
+*/
+/**************************************************************************/
+bool Solver::Is_Dead(u64 hash)
+{
+	return dead_states[hash & dead_mask].load(std::memory_order_relaxed) == hash;
+}
+
+/**************************************************************************/
+/*!
+	 This function records that a state cannot win. The table is lossy, a
+	 state pushed out is only searched again
+*/
+/**************************************************************************/
+void Solver::Mark_Dead(u64 hash)
+{
+	dead_states[hash & dead_mask].store(hash, std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+/*!
+	 This function finds what it costs to get from every tile to the
+	 arsonist. A step onto a passable tile costs 1, steps onto tiles that
+	 have to burn out, wear down or be turned to earth first cost more
+*/
+/**************************************************************************/
+void Solver::Find_Distances(Solver_Slot& slot)
+{
+	Map& map = slot.world.map;
+	s32 const x_size{ map.Get_X_Size() }, y_size{ map.Get_Y_Size() };
+	Tile_Grid grid{ map.Get_Display_Grid() };
+	slot.distance.assign(static_cast<size_t>(x_size) * static_cast<size_t>(y_size), FAR);
+	slot.buckets.resize(static_cast<size_t>(MOST_COST) + 1);
+
+	// Costs are small, so tiles are taken from one bucket per distance
+	s32 const goal{ goals.arsonist_y * x_size + goals.arsonist_x };
+	slot.distance[goal] = 0;
+	slot.buckets[0].push_back(goal);
+	size_t pending{ 1 };
+	for (s32 distance{}; pending > 0; ++distance)
+	{
+		std::vector<s32>& bucket = slot.buckets[static_cast<size_t>(distance % (MOST_COST + 1))];
+		for (size_t i{}; i < bucket.size(); ++i)
+		{
+			s32 const tile{ bucket[i] };
+			--pending;
+			s32 const x_value{ tile % x_size }, y_value{ tile / x_size };
+			s32 const cost{ Step_Cost(grid[y_value][x_value]) };
+			if (slot.distance[tile] != distance || cost == FAR)
+				continue;
+			for (s32 direction{}; direction < 4; ++direction)
+			{
+				s32 const x{ x_value + DIRECTION_X[direction] }, y{ y_value + DIRECTION_Y[direction] };
+				if (x < 0 || y < 0 || x >= x_size || y >= y_size)
+					continue;
+				s32 const neighbour{ y * x_size + x };
+				if (distance + cost < slot.distance[neighbour])
+				{
+					slot.distance[neighbour] = distance + cost;
+					slot.buckets[static_cast<size_t>((distance + cost) % (MOST_COST + 1))].push_back(neighbour);
+					++pending;
+				}
+			}
+		}
+		bucket.clear();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function fills in the actions a state tries, in order. Moves and
+	 earth along the cheapest way to the arsonist go first when running,
+	 spells on the fire go first when fighting it. Threads with the same
+	 strategy start on different directions
+*/
+/**************************************************************************/
+void Solver::Make_Actions(Solver_Slot& slot, Solver_Node& node, s32 order)
+{
+	World& world = slot.world;
+	Map& map = world.map;
+	Tile_Grid grid{ map.Get_Display_Grid() };
+	s32 const x_size{ map.Get_X_Size() }, y_size{ map.Get_Y_Size() };
+	s32 const tick{ world.Get_Ticks_Run() };
+	s32 x_value{}, y_value{};
+	world.player.Get_Player_Tiles_Coordinates(x_value, y_value);
+	node.actions.clear();
+	node.next = 0;
+
+	// Cost of getting to the arsonist through each neighbour
+	Find_Distances(slot);
+	auto through = [&slot, &grid, x_size](s32 x, s32 y)
+		{
+			s32 const distance{ slot.distance[static_cast<size_t>(y) * static_cast<size_t>(x_size) + static_cast<size_t>(x)] };
+			s32 const cost{ Step_Cost(grid[y][x]) };
+			return distance == FAR || cost == FAR ? FAR : distance + cost;
+		};
+	s32 const here{ slot.distance[static_cast<size_t>(y_value) * static_cast<size_t>(x_size) + static_cast<size_t>(x_value)] };
+
+	std::pair<s32, Solver_Action> moves[4]{};
+	s32 move_count{};
+	if (node.move_tick <= tick)
+	{
+		for (s32 i{}; i < 4; ++i)
+		{
+			s32 const direction{ (i + order / STRATEGIES) % 4 };
+			s32 const x{ x_value + DIRECTION_X[direction] }, y{ y_value + DIRECTION_Y[direction] };
+			if (x < 0 || y < 0 || x >= x_size || y >= y_size || !grid[y][x].Is_Passable() || grid[y][x].Get_Fire() > 0)
+				continue;
+			moves[move_count++] = { through(x, y), Solver_Action{ MOVE, static_cast<s8>(direction) } };
+		}
+		std::stable_sort(moves, moves + move_count,
+			[](std::pair<s32, Solver_Action> const& lhs, std::pair<s32, Solver_Action> const& rhs) { return lhs.first < rhs.first; });
+	}
+
+	// Earth on the tiles in the way, nearest first, while they are in range
+	std::vector<Solver_Action> path_casts{};
+	if (node.spell_tick[Player::EARTH] <= tick && here != FAR)
+	{
+		s32 x{ x_value }, y{ y_value };
+		while (path_casts.size() < CAST_TARGETS && (x != goals.arsonist_x || y != goals.arsonist_y))
+		{
+			s32 next_x{ x }, next_y{ y }, best{ FAR };
+			for (s32 direction{}; direction < 4; ++direction)
+			{
+				s32 const step_x{ x + DIRECTION_X[direction] }, step_y{ y + DIRECTION_Y[direction] };
+				if (step_x >= 0 && step_y >= 0 && step_x < x_size && step_y < y_size && through(step_x, step_y) < best)
+				{
+					best = through(step_x, step_y);
+					next_x = step_x;
+					next_y = step_y;
+				}
+			}
+			x = next_x;
+			y = next_y;
+			if (best == FAR || std::abs(x - x_value) + std::abs(y - y_value) > PLAYER_EARTH_RANGE)
+				break;
+			if (Step_Cost(grid[y][x]) == EARTH_COST)
+			{
+				path_casts.push_back(Solver_Action{ CAST, Player::EARTH, x, y });
+			}
+		}
+	}
+
+	// Spells on the fire only go where they can change what it does
+	std::vector<Solver_Action> fire_casts{};
+	std::vector<std::pair<s32, Solver_Action>> targets{};
+	if (!map.Get_Burning_Tiles().empty())
+	{
+		// Water on the burning tiles with the most left to burn around them, nearest first
+		if (node.spell_tick[Player::WATER] <= tick)
+		{
+			for (s32 tile : map.Get_Burning_Tiles())
+			{
+				s32 const x{ tile % x_size }, y{ tile / x_size };
+				s32 const range{ std::abs(x - x_value) + std::abs(y - y_value) };
+				if (range <= PLAYER_WATER_RANGE)
+				{
+					targets.push_back({ Fuel_Around(grid, x, y) * 16 - range, Solver_Action{ CAST, Player::WATER, x, y } });
+				}
+			}
+			Add_Best(targets, fire_casts);
+		}
+
+		// Earth on the tiles the fire reaches next, to break its way
+		if (node.spell_tick[Player::EARTH] <= tick)
+		{
+			targets.clear();
+			Bit_Plane const& near_fire = map.Get_Plane(Tile_Planes::NEAR_FIRE);
+			Bit_Plane const& burning = map.Get_Plane(Tile_Planes::BURNING);
+			Bit_Plane const& wet = map.Get_Plane(Tile_Planes::WET);
+			for (s32 y{ std::max(y_value - PLAYER_EARTH_RANGE, 0) }; y <= std::min(y_value + PLAYER_EARTH_RANGE, y_size - 1); ++y)
+			{
+				s32 const reach{ PLAYER_EARTH_RANGE - std::abs(y - y_value) };
+				s32 const x_first{ std::max(x_value - reach, 0) };
+				s32 const x_last{ std::min(x_value + reach, x_size - 1) };
+				// Tiles near fire with no fire or water on them, a word of tiles at a time
+				for (s32 word{ x_first / Bit_Plane::WORD_BITS }; word <= x_last / Bit_Plane::WORD_BITS; ++word)
+				{
+					u64 bits{ near_fire.Row(y)[word] & ~burning.Row(y)[word] & ~wet.Row(y)[word] & Bit_Plane::Run_Mask(word, x_first, x_last) };
+					for (; bits != 0; bits &= bits - 1)
+					{
+						s32 const x{ word * Bit_Plane::WORD_BITS + Bit_Plane::Lowest_Bit(bits) };
+						Tiles const& tile = grid[y][x];
+						if ((x == x_value && y == y_value) || tile.Get_Tile_Type() == Map::RIVER
+							|| tile.Get_Terrain_Type() == Map::MOUNTAIN || tile.Get_Terrain_Type() == Map::ENEMY)
+							continue;
+						targets.push_back({ Fuel_Around(grid, x, y) * 16 - std::abs(x - x_value) - std::abs(y - y_value),
+							Solver_Action{ CAST, Player::EARTH, x, y } });
+					}
+				}
+			}
+			Add_Best(targets, fire_casts);
+		}
+
+		// Wind, one way each
+		if (node.spell_tick[Player::AIR] <= tick)
+		{
+			for (s32 direction{}; direction < 4; ++direction)
+			{
+				s32 const x{ x_value + DIRECTION_X[direction] }, y{ y_value + DIRECTION_Y[direction] };
+				if (x >= 0 && y >= 0 && x < x_size && y < y_size)
+				{
+					fire_casts.push_back(Solver_Action{ CAST, Player::AIR, x, y });
+				}
+			}
+		}
+	}
+
+	// Moves that keep to the cheapest way to the arsonist
+	s32 closer{};
+	while (closer < move_count && here != FAR && moves[closer].first <= here)
+	{
+		++closer;
+	}
+	if (order % STRATEGIES == FIGHT)
+	{
+		node.actions.insert(node.actions.end(), fire_casts.begin(), fire_casts.end());
+	}
+	for (s32 i{}; i < closer; ++i)
+	{
+		node.actions.push_back(moves[i].second);
+	}
+	node.actions.insert(node.actions.end(), path_casts.begin(), path_casts.end());
+	node.actions.push_back(Solver_Action{ WAIT });
+	if (order % STRATEGIES == RUN)
+	{
+		node.actions.insert(node.actions.end(), fire_casts.begin(), fire_casts.end());
+	}
+	for (s32 i{ closer }; i < move_count; ++i)
+	{
+		node.actions.push_back(moves[i].second);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function searches one slot's World depth first from the start of
+	 the level, for a win that fails none of the goals kept, for at most
+	 seconds. Stops when any thread finds one
+*/
+/**************************************************************************/
+void Solver::Search(Solver_Slot& slot, u8 kept, s32 order, f64 seconds)
+{
+	std::chrono::steady_clock::time_point const deadline{ std::chrono::steady_clock::now()
+		+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<f64>(seconds)) };
+	World& world = slot.world;
+	world.Initialize();
+	slot.complete = false;
+
+	Solver_Node& root = slot.path[0];
+	root.player.Restore(world.player);
+	root.failed = 0;
+	root.spell = Player::WATER;
+	root.move_tick = 0;
+	std::fill(std::begin(root.spell_tick), std::end(root.spell_tick), 0);
+	root.hash = State_Hash(world, root, kept);
+	Make_Actions(slot, root, order);
+
+	u64 states{};
+	s32 depth{};
+	while (depth >= 0)
+	{
+		if (found.load(std::memory_order_relaxed) || ((states & 63u) == 0 && std::chrono::steady_clock::now() > deadline))
+		{
+			states_searched += states;
+			return;
+		}
+
+		Solver_Node& node = slot.path[depth];
+		if (node.next >= node.actions.size())
+		{
+			// Every action from here was searched without a win
+			Mark_Dead(node.hash);
+			if (--depth >= 0)
+			{
+				Step_Back(world, slot.path[depth]);
+			}
+			continue;
+		}
+
+		Solver_Action const action{ node.actions[node.next++] };
+		Solver_Node& child = slot.path[depth + 1];
+		child.failed = node.failed;
+		child.spell = node.spell;
+		child.move_tick = node.move_tick;
+		std::copy(std::begin(node.spell_tick), std::end(node.spell_tick), std::begin(child.spell_tick));
+		if (!Apply_Action(world, action, child.spell, depth, nullptr) || world.state == LS_DEFEAT)
+		{
+			world.player.Restore(node.player);
+			world.state = LS_PLAYING;
+			continue;
+		}
+
+		s32 x_value{}, y_value{};
+		world.player.Get_Player_Tiles_Coordinates(x_value, y_value);
+		if (action.action == MOVE)
+		{
+			u8 terrain{ world.map.Get_Tile(x_value, y_value)->Get_Terrain_Type() };
+			f64 cooldown{ 1.0 / PLAYER_BASE_MOVE_SPEED };
+			child.move_tick = depth + Cooldown_Ticks(terrain == Map::BUSH || terrain == Map::HILL ? cooldown * 2 : cooldown);
+		}
+		else if (action.action == CAST)
+		{
+			// The player's cast speed is 1 / FREQUENCY and a cast waits 1 / cast speed, so FREQUENCY seconds
+			f64 const cooldown[Player::TOTAL_SPELLS]{ PLAYER_CAST_WATER_FREQUENCY, PLAYER_CAST_EARTH_FREQUENCY, PLAYER_CAST_AIR_FREQUENCY };
+			child.spell_tick[action.value] = depth + Cooldown_Ticks(cooldown[action.value]);
+		}
+		bool const caught{ x_value == goals.arsonist_x && y_value == goals.arsonist_y };
+
+		world.Run_Ticks(1);
+		++states;
+		child.failed |= Failed_Goals(world);
+		if (world.state == LS_DEFEAT || (child.failed & kept))
+		{
+			Step_Back(world, node);
+			continue;
+		}
+
+		// Caught and still standing a tick later
+		if (caught)
+		{
+			std::lock_guard<std::mutex> lock{ found_mutex };
+			if (!found.load())
+			{
+				found_actions.clear();
+				for (s32 i{}; i <= depth; ++i)
+				{
+					found_actions.push_back(slot.path[i].actions[slot.path[i].next - 1]);
+				}
+				found_failed = child.failed;
+				found.store(true);
+			}
+			states_searched += states;
+			return;
+		}
+
+		// The arsonist has to be reachable, a move a tick, with a tick to spare
+		s32 const ticks{ depth + 1 };
+		if (ticks + std::abs(goals.arsonist_x - x_value) + std::abs(goals.arsonist_y - y_value) + 1 > horizon)
+		{
+			Step_Back(world, node);
+			continue;
+		}
+		child.hash = State_Hash(world, child, kept);
+		if (Is_Dead(child.hash))
+		{
+			Step_Back(world, node);
+			continue;
+		}
+		child.player.Restore(world.player);
+		Make_Actions(slot, child, order);
+		++depth;
+	}
+	slot.complete = true;
+	states_searched += states;
+}
+
+/**************************************************************************/
+/*!
+	 This function plays a win found by the search from the start of the
+	 level and records it into a Replay
+*/
+/**************************************************************************/
+Replay Solver::Make_Witness(std::vector<Solver_Action> const& actions)
+{
+	World& world = slots[0]->world;
+	world.Initialize();
+	Replay witness{};
+	witness.Start_Recording(level_file, Get_Random_Seed());
+	s8 spell{ Player::WATER };
+	for (size_t tick{}; tick < actions.size(); ++tick)
+	{
+		Apply_Action(world, actions[tick], spell, static_cast<s32>(tick), &witness);
+		world.Run_Ticks(1);
+	}
+	witness.Stop_Recording(world);
+	return witness;
+}
+
+/**************************************************************************/
+/*!
+	 This function loads a level file and searches it for every combination
+	 of its objectives, the biggest first. A win that keeps more goals
+	 answers every combination it keeps, so only combinations not won yet
+	 are searched. SOLVE_TIME is shared among them. Returns false if the
+	 level could not be loaded
+*/
+/**************************************************************************/
+bool Solver::Solve(std::string const& level)
+{
+	level_file = level;
+	results.clear();
+	states_searched = 0;
+	if (BEHAVIOUR_TIME <= 0)
+		return false;
+
+	s32 const thread_count{ thread_pool.Get_Thread_Count() };
+	s32 const slot_count{ std::max(thread_count, static_cast<s32>(STRATEGIES)) };
+	horizon = std::max(static_cast<s32>(SOLVE_HORIZON / BEHAVIOUR_TIME), 1);
+	slots.clear();
+	for (s32 i{}; i < slot_count; ++i)
+	{
+		slots.push_back(std::make_unique<Solver_Slot>());
+		Solver_Slot& slot = *slots.back();
+		if (!slot.world.Load(level))
+		{
+			slots.clear();
+			return false;
+		}
+		// Deep enough to step back from the horizon to the start
+		slot.world.Set_Rewind_Time((horizon + 2) * BEHAVIOUR_TIME);
+		slot.path.resize(static_cast<size_t>(horizon) + 2);
+	}
+
+	goals = slots[0]->world.objectives.Get_Goals();
+	level_goals = static_cast<u8>((goals.time_limit ? TIME_LIMIT : 0) | (goals.tree_count ? TREE_COUNT : 0) | (goals.save_house ? SAVE_HOUSE : 0));
+	if (goals.time_limit)
+	{
+		horizon = std::min(horizon, std::max(static_cast<s32>(goals.time_limit_seconds / BEHAVIOUR_TIME), 1));
+	}
+	if (!dead_states)
+	{
+		dead_states = std::make_unique<std::atomic<u64>[]>(DEAD_STATES_SIZE);
+		dead_mask = DEAD_STATES_SIZE - 1;
+	}
+	for (size_t i{}; i < DEAD_STATES_SIZE; ++i)
+	{
+		dead_states[i].store(0, std::memory_order_relaxed);
+	}
+
+	// Every combination of the level's goals, the most goals first
+	std::vector<u8> combinations{};
+	for (s32 kept{ level_goals };; kept = (kept - 1) & level_goals)
+	{
+		combinations.push_back(static_cast<u8>(kept));
+		if (kept == 0)
+			break;
+	}
+	auto goal_count = [](u8 kept) { return (kept & 1) + (kept >> 1 & 1) + (kept >> 2 & 1); };
+	std::stable_sort(combinations.begin(), combinations.end(), [&goal_count](u8 lhs, u8 rhs) { return goal_count(lhs) > goal_count(rhs); });
+
+	f64 time_left{ SOLVE_TIME };
+	for (size_t i{}; i < combinations.size(); ++i)
+	{
+		Solver_Result result{};
+		result.goals = combinations[i];
+		for (Solver_Result const& won : results)
+		{
+			if (won.achievable && (result.goals & ~won.goals_won) == 0)
+			{
+				result = won;
+				result.goals = combinations[i];
+				break;
+			}
+		}
+		if (result.achievable || !goals.catch_arsonist)
+		{
+			// Nothing wins a level without an arsonist to catch
+			result.exhausted = !goals.catch_arsonist;
+			results.push_back(result);
+			continue;
+		}
+
+		// Threads beyond the pool's run after it, in the time of the ones before them
+		f64 const budget{ time_left / static_cast<f64>(combinations.size() - i) };
+		f64 const seconds{ budget * std::min(static_cast<f64>(thread_count) / slot_count, 1.0) };
+		found = false;
+		std::chrono::steady_clock::time_point const start{ std::chrono::steady_clock::now() };
+		thread_pool.Run(slot_count, [this, &result, seconds](s32 slot_index)
+			{
+				Search(*slots[slot_index], result.goals, slot_index, seconds);
+			});
+		time_left = std::max(time_left - std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count(), 0.0);
+
+		if (found)
+		{
+			result.achievable = true;
+			result.goals_won = static_cast<u8>(level_goals & ~found_failed);
+			result.stars = static_cast<u8>(1 + goals.empty + goal_count(result.goals_won));
+			result.witness = Make_Witness(found_actions);
+		}
+		else
+		{
+			for (std::unique_ptr<Solver_Slot> const& slot : slots)
+			{
+				result.exhausted = result.exhausted || slot->complete;
+			}
+		}
+		results.push_back(result);
+	}
+	return true;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the combinations searched by the last Solve, the
+	 most goals first
+*/
+/**************************************************************************/
+std::vector<Solver_Result> const& Solver::Get_Results()
+{
+	return results;
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the most stars a witness of the last Solve wins,
+	 0 if the level could not be won
+*/
+/**************************************************************************/
+u8 Solver::Get_Max_Stars()
+{
+	u8 stars{};
+	for (Solver_Result const& result : results)
+	{
+		stars = std::max(stars, result.stars);
+	}
+	return stars;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of states the last Solve searched
+*/
+/**************************************************************************/
+u64 Solver::Get_States_Searched()
+{
+	return states_searched;
+}
@@ -0,0 +1,132 @@
+/******************************************************************************/
+/*!
+\file		Solver.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the Solver class. The solver plays a level file
+			headless, searching over the player's moves and spells one tick at
+			a time against the fixed tick simulation, and finds out which
+			combinations of the level's objectives can be won together. Every
+			combination found comes with a witness, a Replay that wins it.
+			The search is depth first and steps back through the World's
+			rewind ring. States whose every move was searched without a win
+			go into a transposition table shared by all threads, so no thread
+			searches them again. Moves that lose the level or fail an
+			objective being kept are cut off at once.
+			Each thread searches with its own World and its own order of
+			trying moves, some run for the arsonist first and some fight the
+			fire first.
+			The main functions of Solver.cpp are:
+			-Solve
+				Searches a level file for every combination of its objectives
+			-Get_Results
+				Whether each combination was won, with its witness
+			-Get_Max_Stars
+				Most stars any witness wins
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+#include "World.hpp"
+#include "Replay.hpp"
+#include <atomic>						// Shared table and stop flag
+#include <memory>						// Slots own their World
+
+extern f64 SOLVE_TIME;
+extern f64 SOLVE_HORIZON;
+
+// One thing the player does before a tick
+struct Solver_Action
+{
+	u8 action{};				// Solver::ACTION
+	s8 value{};					// Direction of MOVE, spell of CAST
+	s32 x{}, y{};				// Tile of CAST
+};
+
+// A state on the path being searched, at the start of the tick of its depth
+struct Solver_Node
+{
+	Player player{};					// Put back after stepping back to this state
+	u8 failed{};						// Solver::GOAL failed on the way here
+	s8 spell{};							// Spell the player has selected
+	s32 move_tick{};					// First tick the player can move on
+	s32 spell_tick[Player::TOTAL_SPELLS]{};	// First tick each spell can be cast on
+	u64 hash{};
+	std::vector<Solver_Action> actions{};	// In the order they are tried
+	size_t next{};						// Next action to try
+};
+
+// The World one thread searches in, with its scratch
+struct Solver_Slot
+{
+	World world{};
+	std::vector<Solver_Node> path{};	// path[tick] is the state after tick ticks
+	std::vector<s32> distance{};		// Cost of getting to the arsonist from each tile
+	std::vector<std::vector<s32>> buckets{};	// Tiles to visit by distance
+	bool complete{};					// The last search ran out of states and not time
+};
+
+// Whether one combination of objectives can be won together
+struct Solver_Result
+{
+	u8 goals{};							// Solver::GOAL kept, catching the arsonist is always needed
+	u8 goals_won{};						// Solver::GOAL the witness keeps, can be more than goals
+	bool achievable{};
+	bool exhausted{};					// Not achievable and every state within the horizon was searched
+	u8 stars{};							// Stars the witness wins
+	Replay witness{};
+};
+
+class Solver
+{
+	std::string level_file{};
+	Objectives_Goals goals{};
+	u8 level_goals{};					// Solver::GOAL the level has
+	s32 horizon{};						// Ticks a search goes on for
+	std::vector<std::unique_ptr<Solver_Slot>> slots{};
+	std::unique_ptr<std::atomic<u64>[]> dead_states{};	// Hashes of states that cannot win
+	size_t dead_mask{};
+	std::atomic<bool> found{};
+	std::mutex found_mutex{};
+	std::vector<Solver_Action> found_actions{};	// Action of every tick of the win, guarded by found_mutex
+	u8 found_failed{};
+	std::atomic<u64> states_searched{};
+	std::vector<Solver_Result> results{};
+
+	u8 Failed_Goals(World& world);
+
+	u64 State_Hash(World& world, Solver_Node const& node, u8 kept);
+
+	bool Is_Dead(u64 hash);
+
+	void Mark_Dead(u64 hash);
+
+	void Find_Distances(Solver_Slot& slot);
+
+	void Make_Actions(Solver_Slot& slot, Solver_Node& node, s32 order);
+
+	void Search(Solver_Slot& slot, u8 kept, s32 order, f64 seconds);
+
+	Replay Make_Witness(std::vector<Solver_Action> const& actions);
+
+public:
+	enum GOAL : u8 {
+		TIME_LIMIT = 1, TREE_COUNT = 2, SAVE_HOUSE = 4
+	};
+	enum ACTION : u8 {
+		WAIT = 0, MOVE, CAST
+	};
+
+	bool Solve(std::string const& level);
+
+	std::vector<Solver_Result> const& Get_Results();
+
+	u8 Get_Max_Stars();
+
+	u64 Get_States_Searched();
+};
@@ -20,6 +20,8 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Main_Menu.hpp"
 #include "Audio.hpp"
 #include "File_Load.hpp"
+#include "Thread_Pool.hpp"
+#include "Random.hpp"
 
 // All Fonts are initialized here and declared using extern on their respective header
 s8 p_font{};			 
@@ -65,6 +67,12 @@ void System_Initialize()
 	// Load Game Parameters (File Read)
 	Load_Game_Parameters();
 
+	// Worker threads for the Map tick
+	thread_pool.Start();
+
+	// Seed the random number service once, a fixed seed replays a run
+	Seed_Random(std::random_device{}());
+
 	// Check User Data
 	tutorial_done = Check_User_Data();
 
@@ -110,6 +118,9 @@ void System_Exit()
 	// Unload Mesh
 	AEGfxMeshFree(p_mesh);
 
+	// Join worker threads
+	thread_pool.Stop();
+
 	// End Alpha Engine
 	AESysExit();
 }
\ No newline at end of file
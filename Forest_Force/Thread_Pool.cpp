@@ -0,0 +1,186 @@
+/******************************************************************************/
+/*!
+\file		Thread_Pool.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the persistent worker threads used to split
+			large jobs such as the Map tick across cores.
+			The main functions of Thread_Pool.cpp are:
+			-Start
+				Creates the worker threads, once at application launch
+			-Stop
+				Wakes and joins the worker threads on application exit
+			-Run
+				Runs a numbered set of tasks on the workers and the calling
+				thread and returns when all of them are done
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Thread_Pool.hpp"
+
+Thread_Pool thread_pool;
+
+/**************************************************************************/
+/*!
+	 Thread_Pool Destructor, joins the workers if Stop was not called
+*/
+/**************************************************************************/
+Thread_Pool::~Thread_Pool()
+{
+	Stop();
+}
+
+/**************************************************************************/
+/*!
+	 This function creates worker_count worker threads. A negative count
+	 creates one per core other than the calling thread
+*/
+/**************************************************************************/
+void Thread_Pool::Start(s32 worker_count)
+{
+	if (!workers.empty())
+		return;
+
+	if (worker_count < 0)
+	{
+		s32 cores{ static_cast<s32>(std::thread::hardware_concurrency()) };
+		worker_count = cores > 1 ? cores - 1 : 0;
+	}
+	stopping = false;
+	for (s32 i{}; i < worker_count; ++i)
+	{
+		workers.emplace_back(&Thread_Pool::Worker_Loop, this);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function wakes and joins all worker threads
+*/
+/**************************************************************************/
+void Thread_Pool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of threads a job runs on, the
+	 workers plus the calling thread
+*/
+/**************************************************************************/
+s32 Thread_Pool::Get_Thread_Count()
+{
+	return static_cast<s32>(workers.size()) + 1;
+}
+
+/**************************************************************************/
+/*!
+	 This function runs task(0) to task(tasks - 1) across the workers and
+	 the calling thread, and returns once every task has finished. Without
+	 workers the tasks run in order on the calling thread
+*/
+/**************************************************************************/
+void Thread_Pool::Run(s32 tasks, std::function<void(s32)> const& task)
+{
+	// The workers take one job at a time, a World ticking while another
+	// World's job is running (or from inside a task) does its tasks on its
+	// own thread instead
+	if (workers.empty() || tasks <= 1 || running.exchange(true))
+	{
+		for (s32 i{}; i < tasks; ++i)
+		{
+			task(i);
+		}
+		return;
+	}
+
+	u32 job_generation{};
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		job = &task;
+		task_count = tasks;
+		tasks_left = tasks;
+		job_generation = ++generation;
+		next_task = static_cast<u64>(job_generation) << 32;
+	}
+	wake.notify_all();
+
+	Work(job_generation, tasks, &task);
+
+	// A task only counts down once it has finished, so no worker is still running one after this
+	std::unique_lock<std::mutex> lock{ mutex };
+	done.wait(lock, [this]() { return tasks_left == 0; });
+	job = nullptr;
+	running = false;
+}
+
+/**************************************************************************/
+/*!
+	 This function takes tasks of one job until none are left. A task is
+	 only taken while next_task still holds the job's generation, so a
+	 worker that woke late for a job that has already finished takes
+	 nothing from the job after it
+*/
+/**************************************************************************/
+void Thread_Pool::Work(u32 job_generation, s32 tasks, std::function<void(s32)> const* task)
+{
+	u64 claim{ next_task.load() };
+	while ((claim >> 32) == job_generation && static_cast<s64>(claim & 0xFFFFFFFFull) < tasks)
+	{
+		if (!next_task.compare_exchange_weak(claim, claim + 1))
+			continue;
+		(*task)(static_cast<s32>(claim & 0xFFFFFFFFull));
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			if (--tasks_left == 0)
+			{
+				done.notify_all();
+			}
+		}
+		claim = next_task.load();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function is run by each worker, sleeping until a job is posted
+*/
+/**************************************************************************/
+void Thread_Pool::Worker_Loop()
+{
+	u32 seen{};
+	while (true)
+	{
+		u32 job_generation{};
+		s32 tasks{};
+		std::function<void(s32)> const* task{};
+		{
+			std::unique_lock<std::mutex> lock{ mutex };
+			wake.wait(lock, [this, seen]() { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen = generation;
+			// The job as it was posted, a claim on it fails once a newer job is posted
+			job_generation = generation;
+			tasks = task_count;
+			task = job;
+		}
+
+		Work(job_generation, tasks, task);
+	}
+}
@@ -0,0 +1,64 @@
+/******************************************************************************/
+/*!
+\file		Thread_Pool.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the persistent worker threads used to split
+			large jobs such as the Map tick across cores.
+			The main functions of Thread_Pool.cpp are:
+			-Start
+				Creates the worker threads, once at application launch
+			-Stop
+				Wakes and joins the worker threads on application exit
+			-Run
+				Runs a numbered set of tasks on the workers and the calling
+				thread and returns when all of them are done
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+#include <thread>						// Worker threads
+#include <mutex>						// Guards the job being run
+#include <condition_variable>			// Sleeps workers between jobs
+#include <atomic>						// Hands out task numbers
+#include <functional>					// Task callback
+
+class Thread_Pool
+{
+	std::vector<std::thread> workers{};
+	std::mutex mutex{};
+	std::condition_variable wake{};
+	std::condition_variable done{};
+	std::function<void(s32)> const* job{ nullptr };
+	std::atomic<u64> next_task{};		// Generation of the job in the high 32 bits, its next task in the low 32 bits
+	s32 task_count{};
+	s32 tasks_left{};
+	u32 generation{};
+	bool stopping{};
+	std::atomic<bool> running{};		// Set while the workers are on a job
+
+	void Worker_Loop();
+
+	void Work(u32 job_generation, s32 tasks, std::function<void(s32)> const* task);
+
+public:
+	Thread_Pool() = default;
+	Thread_Pool(Thread_Pool const&) = delete;
+	Thread_Pool& operator=(Thread_Pool const&) = delete;
+	~Thread_Pool();
+
+	void Start(s32 worker_count = -1);
+
+	void Stop();
+
+	s32 Get_Thread_Count();
+
+	void Run(s32 tasks, std::function<void(s32)> const& task);
+};
+
+extern Thread_Pool thread_pool;
@@ -0,0 +1,168 @@
+/******************************************************************************/
+/*!
+\file		Tile_Planes.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the bit planes the Map keeps alongside its grid,
+			one bit a tile for whether it is burning, wet, passable or near
+			fire. Each row is packed into 64 bit words, so asking these about
+			a whole area takes a word of 64 tiles at a time instead of
+			unpacking every tile, as the Solver does for its near fire spots.
+			The main functions of Tile_Planes.cpp are:
+			-Bit_Plane::Run_Mask
+				Bits of a word that are a run of tiles of a row
+			-Tile_Planes::Set_Tile
+				Sets the bits of one tile from its value
+			-Tile_Planes::Rebuild
+				Sets the bits of every tile of a grid
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "Tile_Planes.hpp"
+#include "Map.hpp"
+#include <algorithm>					// std::min, std::max
+#if defined(_MSC_VER)
+#include <intrin.h>						// _BitScanForward64
+#endif
+
+/**************************************************************************/
+/*!
+	 This function sizes the plane for a map, every bit is cleared
+*/
+/**************************************************************************/
+void Bit_Plane::Resize(s32 x_value, s32 y_value)
+{
+	width = std::max(x_value, 0);
+	height = std::max(y_value, 0);
+	row_words = (width + WORD_BITS - 1) / WORD_BITS;
+	words.assign(static_cast<size_t>(row_words) * static_cast<size_t>(height), 0);
+}
+
+/**************************************************************************/
+/*!
+	 This function clears every bit of the plane
+*/
+/**************************************************************************/
+void Bit_Plane::Clear()
+{
+	std::fill(words.begin(), words.end(), 0ull);
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the bits of a word of a row that are the tiles
+	 from x_first to x_last, both included
+*/
+/**************************************************************************/
+u64 Bit_Plane::Run_Mask(s32 word, s32 x_first, s32 x_last)
+{
+	s32 first{ std::max(x_first - word * WORD_BITS, 0) };
+	s32 last{ std::min(x_last - word * WORD_BITS, WORD_BITS - 1) };
+	if (first > last)
+		return 0;
+	return (~0ull >> (WORD_BITS - 1 - last)) & (~0ull << first);
+}
+
+/**************************************************************************/
+/*!
+	 This function returns the lowest bit set in a word, word must not be 0
+*/
+/**************************************************************************/
+s32 Bit_Plane::Lowest_Bit(u64 word)
+{
+#if defined(_MSC_VER)
+	unsigned long bit{};
+	_BitScanForward64(&bit, word);
+	return static_cast<s32>(bit);
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+/**************************************************************************/
+/*!
+	 This function sizes every plane for a map, every bit is cleared
+*/
+/**************************************************************************/
+void Tile_Planes::Resize(s32 x_value, s32 y_value)
+{
+	for (Bit_Plane& plane : planes)
+	{
+		plane.Resize(x_value, y_value);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function frees every plane, when the Map is unloaded
+*/
+/**************************************************************************/
+void Tile_Planes::Clear()
+{
+	for (Bit_Plane& plane : planes)
+	{
+		plane = Bit_Plane{};
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function sets the bits of one tile from its value, call it
+	 whenever a tile of the grid the planes follow is written
+*/
+/**************************************************************************/
+void Tile_Planes::Set_Tile(s32 x_value, s32 y_value, Tiles const& tile)
+{
+	planes[BURNING].Set(x_value, y_value, tile.Get_Fire() > 0);
+	planes[WET].Set(x_value, y_value, tile.Get_Fire() < 0);
+	planes[PASSABLE].Set(x_value, y_value, tile.Is_Passable());
+	planes[NEAR_FIRE].Set(x_value, y_value, tile.Is_Near_Fire());
+}
+
+/**************************************************************************/
+/*!
+	 This function sets the bits of every tile of a grid the size of the
+	 planes, a word of every plane at a time
+*/
+/**************************************************************************/
+void Tile_Planes::Rebuild(Tile_Grid const& grid)
+{
+	Bit_Plane& burning = planes[BURNING];
+	if (grid.memory == nullptr)
+	{
+		for (Bit_Plane& plane : planes)
+		{
+			plane.Clear();
+		}
+		return;
+	}
+
+	for (s32 y{}; y < burning.height; ++y)
+	{
+		Tiles const* row{ grid[y] };
+		for (s32 word{}; word < burning.row_words; ++word)
+		{
+			u64 bits[TOTAL_PLANES]{};
+			s32 const first{ word * Bit_Plane::WORD_BITS };
+			s32 const count{ std::min(burning.width - first, Bit_Plane::WORD_BITS) };
+			for (s32 bit{}; bit < count; ++bit)
+			{
+				Tiles const& tile = row[first + bit];
+				s8 const fire{ tile.Get_Fire() };
+				bits[BURNING] |= static_cast<u64>(fire > 0) << bit;
+				bits[WET] |= static_cast<u64>(fire < 0) << bit;
+				bits[PASSABLE] |= static_cast<u64>(tile.Is_Passable()) << bit;
+				bits[NEAR_FIRE] |= static_cast<u64>(tile.Is_Near_Fire()) << bit;
+			}
+			for (s32 plane{}; plane < TOTAL_PLANES; ++plane)
+			{
+				planes[plane].Row(y)[word] = bits[plane];
+			}
+		}
+	}
+}
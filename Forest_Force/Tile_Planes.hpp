@@ -0,0 +1,78 @@
+/******************************************************************************/
+/*!
+\file		Tile_Planes.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the bit planes the Map keeps alongside its grid,
+			one bit a tile for whether it is burning, wet, passable or near
+			fire. Each row is packed into 64 bit words, so asking these about
+			a whole area takes a word of 64 tiles at a time instead of
+			unpacking every tile, as the Solver does for its near fire spots.
+			The main functions of Tile_Planes.cpp are:
+			-Bit_Plane::Run_Mask
+				Bits of a word that are a run of tiles of a row
+			-Tile_Planes::Set_Tile
+				Sets the bits of one tile from its value
+			-Tile_Planes::Rebuild
+				Sets the bits of every tile of a grid
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+
+struct Tiles;
+struct Tile_Grid;
+
+// One bit a tile of a Map, every row packed into whole 64 bit words.
+// Bits past the end of a row are always 0.
+struct Bit_Plane
+{
+	std::vector<u64> words{};
+	s32 width{};
+	s32 height{};
+	s32 row_words{};				// Words per row
+
+	static constexpr s32 WORD_BITS{ 64 };
+
+	void Resize(s32 x_value, s32 y_value);
+
+	void Clear();
+
+	u64* Row(s32 y_value) { return words.data() + static_cast<size_t>(y_value) * static_cast<size_t>(row_words); }
+
+	u64 const* Row(s32 y_value) const { return words.data() + static_cast<size_t>(y_value) * static_cast<size_t>(row_words); }
+
+	void Set(s32 x_value, s32 y_value, bool value)
+	{
+		u64& word = Row(y_value)[x_value / WORD_BITS];
+		u64 const bit{ 1ull << (x_value % WORD_BITS) };
+		word = value ? word | bit : word & ~bit;
+	}
+
+	static u64 Run_Mask(s32 word, s32 x_first, s32 x_last);
+
+	static s32 Lowest_Bit(u64 word);
+};
+
+// The tile predicates the Map keeps a plane of
+struct Tile_Planes
+{
+	enum PLANE : u8 {
+		BURNING = 0, WET, PASSABLE, NEAR_FIRE, TOTAL_PLANES
+	};
+
+	Bit_Plane planes[TOTAL_PLANES]{};
+
+	void Resize(s32 x_value, s32 y_value);
+
+	void Clear();
+
+	void Set_Tile(s32 x_value, s32 y_value, Tiles const& tile);
+
+	void Rebuild(Tile_Grid const& grid);
+};
@@ -89,7 +89,7 @@ void Get_Mouse_World_Coordinates(s32 &mouse_x, s32 &mouse_y) {
 	This function updates the x and y with mouse tile coordinates.
 */
 /**************************************************************************/
-void Get_Mouse_Tile_Coordinates(s8 &x, s8 &y) {
+void Get_Mouse_Tile_Coordinates(s32 &x, s32 &y) {
 	s32 mouse_x{}, mouse_y{};
 	Get_Mouse_World_Coordinates(mouse_x, mouse_y);
 
@@ -115,8 +115,8 @@ void Get_Mouse_Tile_Coordinates(s8 &x, s8 &y) {
 	}
 	else
 	{
-		x = static_cast<s8>(mouse_x);
-		y = static_cast<s8>(mouse_y);
+		x = mouse_x;
+		y = mouse_y;
 	}
 
 }
@@ -132,17 +132,4 @@ void Get_Mouse_Normalized_Coordinates(f32& mouse_x, f32& mouse_y) {
 	AEInputGetCursorPosition(&m_x, &m_y);
 	mouse_x = (m_x * 2.0f / static_cast<f32>(AEGfxGetWindowWidth())) - 1.0f; // Set mouse X from screen coor to normalized coor
 	mouse_y = 1.0f - (m_y * 2.0f / static_cast<f32>(AEGfxGetWindowHeight())); // Set mouse Y from screen coor to normalized coor
-}
-
-/**************************************************************************/
-/*!
-	This function returns a random float given a min and a max.
-*/
-/**************************************************************************/
-float Random_Float(float min, float max) {
-	std::random_device rd;  // Random number
-	std::default_random_engine eng(rd()); // Seed generator
-	std::uniform_real_distribution<float> distr(min, max); // Define range
-
-	return distr(eng);
 }
\ No newline at end of file
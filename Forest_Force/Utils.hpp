@@ -24,8 +24,6 @@ void Update_Delta_Time(f64& dt);
 
 void Get_Mouse_World_Coordinates(s32& mouse_x, s32& mouse_y);
 
-void Get_Mouse_Tile_Coordinates(s8& x, s8& y);
+void Get_Mouse_Tile_Coordinates(s32& x, s32& y);
 
-void Get_Mouse_Normalized_Coordinates(f32& mouse_x, f32& mouse_y);
-
-float Random_Float(float min, float max);
\ No newline at end of file
+void Get_Mouse_Normalized_Coordinates(f32& mouse_x, f32& mouse_y);
\ No newline at end of file
@@ -28,9 +28,11 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "Water_Particle_System.hpp"
 #include "Map.hpp"
 #include "Player.hpp"
+#include "Random.hpp"
 
 static std::vector<Particle> water_particles;
 static size_t water_alive = 0;
+static std::vector<f32> water_rolls;		// Random values of a spawn burst
 
 /**************************************************************************/
 /*!
@@ -49,28 +51,35 @@ void Water_Particles_Load() {
 */
 /**************************************************************************/
 void Water_Particles_Spawn(s32 tile_x, s32 tile_y) {
-	for (size_t i = 0; i < WATER_PARTICLE_MAX_AMOUNT; ++i) {
-		if (water_alive < WATER_PARTICLE_MAX_AMOUNT) {
-			Particle data = {};
-			data.x = static_cast<f32>(tile_x);
-			data.y = static_cast<f32>(tile_y);
-			f32 vel_x = Random_Float(-WATER_PARTICLE_VELOCITY, WATER_PARTICLE_VELOCITY);
-			f32 vel_y = Random_Float(-WATER_PARTICLE_VELOCITY, WATER_PARTICLE_VELOCITY);
-			data.vel_x = (vel_x - vel_y) * sinf(PI / 4.0f);	// 45 deg rotation (factorized, sin45 = cos45)
-			data.vel_y = (vel_x + vel_y) * sinf(PI / 4.0f);	// 45 deg rotation (factorized, sin45 = cos45)
-			data.lifetime = Random_Float(static_cast<f32>(WATER_PARTICLE_LIFETIME_MIN), static_cast<f32>(WATER_PARTICLE_LIFETIME_MAX));
-			data.scale_x = WATER_PARTICLE_SCALE;
-			data.scale_y = WATER_PARTICLE_SCALE;
-			data.rotation = Random_Float(0.0f, 2.0f * PI);
-
-			data.color_r = 0.f;
-			data.color_g = 0.f;
-			data.color_b = 1.0f;
-	
+	size_t spawn = WATER_PARTICLE_MAX_AMOUNT - water_alive;
 
-			++water_alive;
-			water_particles[water_alive - 1] = data;
-		}
+	// Roll the whole burst at once, one value range after another
+	water_rolls.resize(spawn * 4);
+	f32* vel_x = water_rolls.data();
+	f32* vel_y = vel_x + spawn;
+	f32* lifetime = vel_y + spawn;
+	f32* rotation = lifetime + spawn;
+	Random& random = Thread_Random();
+	random.Fill_Range(vel_x, spawn * 2, -WATER_PARTICLE_VELOCITY, WATER_PARTICLE_VELOCITY);
+	random.Fill_Range(lifetime, spawn, static_cast<f32>(WATER_PARTICLE_LIFETIME_MIN), static_cast<f32>(WATER_PARTICLE_LIFETIME_MAX));
+	random.Fill_Range(rotation, spawn, 0.0f, 2.0f * PI);
+
+	for (size_t i = 0; i < spawn; ++i) {
+		Particle data = {};
+		data.x = static_cast<f32>(tile_x);
+		data.y = static_cast<f32>(tile_y);
+		data.vel_x = (vel_x[i] - vel_y[i]) * sinf(PI / 4.0f);	// 45 deg rotation (factorized, sin45 = cos45)
+		data.vel_y = (vel_x[i] + vel_y[i]) * sinf(PI / 4.0f);	// 45 deg rotation (factorized, sin45 = cos45)
+		data.lifetime = lifetime[i];
+		data.scale_x = WATER_PARTICLE_SCALE;
+		data.scale_y = WATER_PARTICLE_SCALE;
+		data.rotation = rotation[i];
+
+		data.color_r = 0.f;
+		data.color_g = 0.f;
+		data.color_b = 1.0f;
+
+		water_particles[water_alive++] = data;
 	}
 }
 
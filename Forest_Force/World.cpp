@@ -0,0 +1,405 @@
+/******************************************************************************/
+/*!
+\file		World.cpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the World class. A World owns everything one
+			running level needs (the Map, the Player, the Objectives, the
+			level state and the tick timers) so that many levels can be
+			simulated side by side in one process.
+			The main functions of World.cpp are:
+			-Load
+				Reads a level file into the World, without loading any assets
+			-Initialize
+				Resets the World to the start of its level
+			-Update
+				Spends frame time on fixed ticks of the simulation
+			-Tick
+				Runs one tick and checks if the player got caught in the fire
+			-Get_Events
+				Events of the ticks run by the last Update, for objectives,
+				particles, audio and UI to react to
+			-Take_Snapshot / Restore_Snapshot
+				Saves the whole World and puts it back later, the grids are
+				copy on write so a restore costs the tiles changed since
+			-Rewind
+				Steps the World back through its last ticks
+			-Rewind_Update
+				Spends frame time stepping back, at the pace Update steps on
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#include "pch.hpp"
+#include "World.hpp"
+#include "Fileio.hpp"
+#include <cmath>						// std::fmod
+
+World game_world;
+
+// The level being played is game_world
+Map& level_map{ game_world.map };
+Player& player{ game_world.player };
+Objectives& objectives{ game_world.objectives };
+
+/**************************************************************************/
+/*!
+	 World Constructor, points the Player and Objectives at this World
+*/
+/**************************************************************************/
+World::World()
+{
+	player.Set_World(*this);
+	objectives.Set_World(*this);
+}
+
+/**************************************************************************/
+/*!
+	 World Destructor, frees the level if it was not unloaded
+*/
+/**************************************************************************/
+World::~World()
+{
+	objectives.Unload();
+	map.Map_Unload();
+}
+
+/**************************************************************************/
+/*!
+	 This function reads a level file into the World. Assets are not
+	 loaded, so a World can be loaded without AlphaEngine running
+*/
+/**************************************************************************/
+bool World::Load(std::string const& filename)
+{
+	return Read_File(filename, *this) != 0;
+}
+
+/**************************************************************************/
+/*!
+	 This function resets the World to the start of its level
+*/
+/**************************************************************************/
+void World::Initialize()
+{
+	state = LS_PLAYING;
+	tick_accumulator = 0;
+	ticks_run = 0;
+	events.clear();
+	rewind_head = rewind_count = 0;
+	player.Initialize();
+	tick_player.Restore(player);
+	map.Map_Init();
+	objectives.Initialize();
+}
+
+/**************************************************************************/
+/*!
+	 This function updates the simulation of the World. Frame time scaled
+	 by the game speed is banked and spent in fixed ticks of BEHAVIOUR_TIME,
+	 at most MAX_TICKS_PER_FRAME a frame. Time past that is dropped so a
+	 slow frame never snowballs into slower ones. Ticking stops as soon as
+	 a tick ends the level, the time left is dropped with it
+*/
+/**************************************************************************/
+void World::Update(f64 frame_time)
+{
+	tick_accumulator += frame_time * game_speed;
+	events.clear();
+
+	s32 ticks{};
+	while (tick_accumulator >= BEHAVIOUR_TIME && ticks < MAX_TICKS_PER_FRAME && state == LS_PLAYING)
+	{
+		Tick();
+		tick_accumulator -= BEHAVIOUR_TIME;
+		++ticks;
+	}
+	if (state != LS_PLAYING)
+	{
+		tick_accumulator = 0;
+	}
+	else if (tick_accumulator >= BEHAVIOUR_TIME)
+	{
+		tick_accumulator = std::fmod(tick_accumulator, BEHAVIOUR_TIME);
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function advances the World by one tick of BEHAVIOUR_TIME, the
+	 player loses if the tick left them in fire or on impassable terrain
+	 and is warned when fire is next to them
+*/
+/**************************************************************************/
+void World::Tick()
+{
+	if (!rewind_ring.empty())
+	{
+		World_Tick& saved = rewind_ring[rewind_head];
+		saved.player.Restore(tick_player);
+		saved.objectives = objectives.Save_State();
+		saved.state = state;
+		rewind_head = (rewind_head + 1) % static_cast<s32>(rewind_ring.size());
+		rewind_count = std::min(rewind_count + 1, static_cast<s32>(rewind_ring.size()));
+	}
+	map.Simulate_Tick();
+	++ticks_run;
+	objectives.Advance_Time(BEHAVIOUR_TIME);
+	if (Player_Caught())
+	{
+		state = LS_DEFEAT;
+	}
+
+	s32 x_value{}, y_value{};
+	player.Get_Player_Tiles_Coordinates(x_value, y_value);
+	Tiles const& tile = map.Get_Display_Grid()[y_value][x_value];
+	if (tile.Is_Near_Fire() || tile.Get_Fire() > 0)
+	{
+		map.Add_Event(Map::PLAYER_ENDANGERED, x_value, y_value, tile.Get_Fire());
+	}
+	events.insert(events.end(), map.Get_Events().begin(), map.Get_Events().end());
+	tick_player.Restore(player);
+}
+
+/**************************************************************************/
+/*!
+	 This function runs tick_count ticks back to back, without waiting on
+	 frame time
+*/
+/**************************************************************************/
+void World::Run_Ticks(s32 tick_count)
+{
+	events.clear();
+	for (s32 i{}; i < tick_count; ++i)
+	{
+		Tick();
+	}
+}
+
+/**************************************************************************/
+/*!
+	 This function checks if the tile the player is on is burning or has
+	 become impassable
+*/
+/**************************************************************************/
+bool World::Player_Caught()
+{
+	s32 x_value{}, y_value{};
+	player.Get_Player_Tiles_Coordinates(x_value, y_value);
+	Tiles const& tile = map.Get_Display_Grid()[y_value][x_value];
+	return tile.Get_Fire() > 0 || !tile.Is_Passable();
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of ticks run since the level started
+*/
+/**************************************************************************/
+s32 World::Get_Ticks_Run()
+{
+	return ticks_run;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the events of every tick run by the last Update
+	 or Run_Ticks, in tick order
+*/
+/**************************************************************************/
+std::vector<Map_Event> const& World::Get_Events()
+{
+	return events;
+}
+
+/**************************************************************************/
+/*!
+	 This function sets how many times faster than real time the World is
+	 simulated, 1, 2, 4 or 8
+*/
+/**************************************************************************/
+void World::Set_Game_Speed(s32 speed)
+{
+	game_speed = std::min(std::max(speed, 1), MAX_GAME_SPEED);
+}
+
+/**************************************************************************/
+/*!
+	 This function steps the game speed through 1x, 2x, 4x and 8x
+*/
+/**************************************************************************/
+void World::Cycle_Game_Speed()
+{
+	game_speed = game_speed >= MAX_GAME_SPEED ? 1 : game_speed * 2;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the game speed
+*/
+/**************************************************************************/
+s32 World::Get_Game_Speed()
+{
+	return game_speed;
+}
+
+/**************************************************************************/
+/*!
+	 This function saves the whole World, to restart the level or retry a
+	 move from here. Returns the id to restore it with
+*/
+/**************************************************************************/
+s32 World::Take_Snapshot()
+{
+	s32 snapshot_id{};
+	while (snapshot_id < static_cast<s32>(snapshots.size()) && snapshots[snapshot_id].in_use)
+	{
+		++snapshot_id;
+	}
+	if (snapshot_id == static_cast<s32>(snapshots.size()))
+	{
+		snapshots.emplace_back();
+	}
+
+	World_Snapshot& snapshot = snapshots[snapshot_id];
+	snapshot.in_use = true;
+	snapshot.map_snapshot = map.Take_Snapshot();
+	snapshot.player.Restore(player);
+	snapshot.objectives = objectives.Save_State();
+	snapshot.state = state;
+	snapshot.tick_accumulator = tick_accumulator;
+	snapshot.ticks_run = ticks_run;
+	snapshot.events = events;
+	return snapshot_id;
+}
+
+/**************************************************************************/
+/*!
+	 This function puts the World back to the moment the snapshot was
+	 taken. The game speed is left as the player set it
+*/
+/**************************************************************************/
+void World::Restore_Snapshot(s32 snapshot_id)
+{
+	if (snapshot_id < 0 || snapshot_id >= static_cast<s32>(snapshots.size()) || !snapshots[snapshot_id].in_use)
+		return;
+
+	World_Snapshot const& snapshot = snapshots[snapshot_id];
+	map.Restore_Snapshot(snapshot.map_snapshot);
+	player.Restore(snapshot.player);
+	tick_player.Restore(player);
+	objectives.Restore_State(snapshot.objectives);
+	state = snapshot.state;
+	tick_accumulator = snapshot.tick_accumulator;
+	ticks_run = snapshot.ticks_run;
+	events = snapshot.events;
+	rewind_head = rewind_count = 0;
+}
+
+/**************************************************************************/
+/*!
+	 This function frees a snapshot that will not be restored again
+*/
+/**************************************************************************/
+void World::Release_Snapshot(s32 snapshot_id)
+{
+	if (snapshot_id < 0 || snapshot_id >= static_cast<s32>(snapshots.size()) || !snapshots[snapshot_id].in_use)
+		return;
+
+	World_Snapshot& snapshot = snapshots[snapshot_id];
+	map.Release_Snapshot(snapshot.map_snapshot);
+	snapshot.in_use = false;
+	snapshot.map_snapshot = -1;
+	snapshot.events = std::vector<Map_Event>{};
+}
+
+/**************************************************************************/
+/*!
+	 This function sets how many seconds of game time are kept to be
+	 stepped back through by Rewind, 0 turns rewinding off
+*/
+/**************************************************************************/
+void World::Set_Rewind_Time(f64 seconds)
+{
+	s32 ticks{ BEHAVIOUR_TIME > 0 ? static_cast<s32>(seconds / BEHAVIOUR_TIME) : 0 };
+	ticks = std::max(ticks, 0);
+	map.Set_Rewind_Capacity(ticks);
+	rewind_ring.assign(static_cast<size_t>(ticks), World_Tick{});
+	rewind_head = rewind_count = 0;
+}
+
+/**************************************************************************/
+/*!
+	 This function undoes up to tick_count of the last ticks and returns
+	 how many were undone. The objectives go back to how they were at the
+	 start of the oldest tick undone, and the player to how the tick before
+	 it left them, as the spells queued for that tick are dropped
+*/
+/**************************************************************************/
+s32 World::Rewind(s32 tick_count)
+{
+	s32 ticks{ map.Rewind(std::min(tick_count, rewind_count)) };
+	if (ticks <= 0)
+		return 0;
+
+	s32 const ring_size{ static_cast<s32>(rewind_ring.size()) };
+	rewind_head = (rewind_head + ring_size - ticks) % ring_size;
+	rewind_count -= ticks;
+	ticks_run -= ticks;
+	World_Tick const& saved = rewind_ring[rewind_head];
+	player.Restore(saved.player);
+	tick_player.Restore(player);
+	objectives.Restore_State(saved.objectives);
+	state = saved.state;
+	tick_accumulator = 0;
+	events.clear();
+	return ticks;
+}
+
+/**************************************************************************/
+/*!
+	 This function steps the World back at the pace Update steps it
+	 forward. Frame time scaled by the game speed is banked and spent
+	 undoing whole ticks, at most MAX_TICKS_PER_FRAME a frame, and the
+	 number of ticks undone is returned
+*/
+/**************************************************************************/
+s32 World::Rewind_Update(f64 frame_time)
+{
+	tick_accumulator += frame_time * game_speed;
+	events.clear();
+
+	s32 const ticks{ std::min(static_cast<s32>(tick_accumulator / BEHAVIOUR_TIME), MAX_TICKS_PER_FRAME) };
+	f64 const time_left{ std::fmod(tick_accumulator, BEHAVIOUR_TIME) };
+	s32 const undone{ ticks > 0 ? Rewind(ticks) : 0 };
+
+	// Rewind drops the banked time, keep what is left of this frame's
+	tick_accumulator = time_left;
+	return undone;
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the number of ticks Rewind can undo
+*/
+/**************************************************************************/
+s32 World::Get_Rewind_Ticks()
+{
+	return std::min(rewind_count, map.Get_Rewind_Ticks());
+}
+
+/**************************************************************************/
+/*!
+	 Accessor function to the Zobrist hash of the Map's state with the tile
+	 the player stands on. Player spell cooldowns and the objectives are
+	 not in it
+*/
+/**************************************************************************/
+u64 World::Get_State_Hash()
+{
+	s32 x_value{}, y_value{};
+	player.Get_Player_Tiles_Coordinates(x_value, y_value);
+	return map.Get_State_Hash() ^ map.Get_Position_Key(x_value, y_value);
+}
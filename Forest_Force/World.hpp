@@ -0,0 +1,137 @@
+/******************************************************************************/
+/*!
+\file		World.hpp
+\author 	agent
+\par    	Email: agent@local
+\par    	Project: Forest Force
+\date   	October 17, 2026
+\brief		This file contains the World class. A World owns everything one
+			running level needs (the Map, the Player, the Objectives, the
+			level state and the tick timers) so that many levels can be
+			simulated side by side in one process.
+			The game plays game_world, level_map, player, objectives and
+			level_state refer to its members.
+			The main functions of World.cpp are:
+			-Load
+				Reads a level file into the World, without loading any assets
+			-Initialize
+				Resets the World to the start of its level
+			-Update
+				Spends frame time on fixed ticks of the simulation
+			-Tick
+				Runs one tick and checks if the player got caught in the fire
+			-Get_Events
+				Events of the ticks run by the last Update, for objectives,
+				particles, audio and UI to react to
+			-Take_Snapshot / Restore_Snapshot
+				Saves the whole World and puts it back later, the grids are
+				copy on write so a restore costs the tiles changed since
+			-Rewind
+				Steps the World back through its last ticks
+			-Rewind_Update
+				Spends frame time stepping back, at the pace Update steps on
+			-Get_State_Hash
+				Hash of the Map's state and the player's tile, to compare
+				Worlds without comparing their grids
+Copyright (C) 2026 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+#pragma once
+#include "pch.hpp"
+#include "Map.hpp"
+#include "Player.hpp"
+#include "Objectives.hpp"
+
+extern s32 MAX_TICKS_PER_FRAME;
+extern f64 REWIND_TIME;
+
+// Everything a World needs to go back to the moment it was saved
+struct World_Snapshot
+{
+	bool in_use{ false };
+	s32 map_snapshot{ -1 };				// Id of the Map's own snapshot
+	Player player{};
+	Objectives_State objectives{};
+	s8 state{};
+	f64 tick_accumulator{};
+	s32 ticks_run{};
+	std::vector<Map_Event> events{};
+};
+
+// The player and objectives at the start of a tick, the Map keeps the rest.
+// The player is kept as the tick before left it, before the input that
+// queued this tick's spells, since the Map drops those spells on a rewind
+struct World_Tick
+{
+	Player player{};
+	Objectives_State objectives{};
+	s8 state{};
+};
+
+class World
+{
+	f64 tick_accumulator{};			// Game time not yet simulated, in seconds
+	s32 game_speed{ 1 };			// Ticks run per BEHAVIOUR_TIME of real time
+	s32 ticks_run{};				// Ticks since the level started
+	std::vector<Map_Event> events{};	// Events of every tick run by the last Update or Run_Ticks
+	std::vector<World_Snapshot> snapshots{};
+	std::vector<World_Tick> rewind_ring{};	// Same slots as the Map's rewind ring
+	s32 rewind_head{};
+	s32 rewind_count{};
+	Player tick_player{};			// The player as the last tick left it, before any input since
+
+public:
+	Map map{};
+	Player player{};
+	Objectives objectives{};
+	s8 state{};
+
+	static constexpr s32 MAX_GAME_SPEED{ 8 };
+
+	World();
+	World(World const&) = delete;
+	World& operator=(World const&) = delete;
+	~World();
+
+	bool Load(std::string const& filename);
+
+	void Initialize();
+
+	void Update(f64 frame_time);
+
+	void Tick();
+
+	void Run_Ticks(s32 tick_count);
+
+	bool Player_Caught();
+
+	s32 Get_Ticks_Run();
+
+	std::vector<Map_Event> const& Get_Events();
+
+	s32 Take_Snapshot();
+
+	void Restore_Snapshot(s32 snapshot_id);
+
+	void Release_Snapshot(s32 snapshot_id);
+
+	void Set_Rewind_Time(f64 seconds);
+
+	s32 Rewind(s32 tick_count);
+
+	s32 Rewind_Update(f64 frame_time);
+
+	s32 Get_Rewind_Ticks();
+
+	u64 Get_State_Hash();
+
+	void Set_Game_Speed(s32 speed);
+
+	void Cycle_Game_Speed();
+
+	s32 Get_Game_Speed();
+};
+
+extern World game_world;